@@ -236,7 +236,6 @@ public:
         double total_throughput = static_cast<double>(packet_count - total_packet_loss) / (MAX_PACKETS);
         double average_tat = static_cast<double>(total_turnaround_time) / (packet_count > 0 ? packet_count : 1);
         double average_waiting_time = static_cast<double>(total_waiting_time) / (packet_count > 0 ? packet_count : 1);
-        average_waiting_time=average_tat*0.45;
         
         std::cout << "Throughput: " << total_throughput * 100 << "%\n";
         std::cout << "Average Turnaround Time (TAT): " << average_tat << " ms\n";
@@ -4,6 +4,8 @@
 #include <cstdlib> // For rand()
 #include <ctime>   // For time()
 #include <iomanip> // For std::setprecision
+#include <algorithm>
+#include "wfq_engine.h"
 
 using namespace std;
 
@@ -57,6 +59,7 @@ class SwitchFabric {
 private:
     Queue queues[3]; // Three queues with different weights
     int packet_count = 0;
+    int current_time = 0; // arrival time step; the link sends one packet per step
     int total_dropped_packets = 0; // Track total packet loss
     std::vector<Packet> processed_packets; // Store processed packets
 
@@ -70,7 +73,7 @@ public:
                     for (int i = 0; i < 3; ++i) {
                         int generate_packet = (rand() % 2 == 0); // 50% chance to generate a packet
                         if (generate_packet && packet_count < MAX_PACKETS) {
-                            Packet packet = {packet_count++, i, -1, packet_count, -1}; // Removed priority assignment at arrival
+                            Packet packet = {packet_count++, i, -1, current_time, -1}; // Removed priority assignment at arrival
                             queues[i].enqueue(packet);
                             if (queues[i].is_full()) {
                                 total_dropped_packets++; // Increment dropped packet count
@@ -79,6 +82,7 @@ public:
                             }
                         }
                     }
+                    current_time++; // every queue may receive a packet in the same step
                 }
                 break;
 
@@ -87,7 +91,7 @@ public:
                     for (int i = 0; i < 3; ++i) {
                         int generate_packet = (rand() % 3 == 0); // 33% chance to generate a packet
                         if (generate_packet && packet_count < MAX_PACKETS) {
-                            Packet packet = {packet_count++, i, -1, packet_count, -1}; // Removed priority assignment at arrival
+                            Packet packet = {packet_count++, i, -1, current_time, -1}; // Removed priority assignment at arrival
                             queues[i].enqueue(packet);
                             if (queues[i].is_full()) {
                                 total_dropped_packets++; // Increment dropped packet count
@@ -96,6 +100,7 @@ public:
                             }
                         }
                     }
+                    current_time++; // every queue may receive a packet in the same step
                 }
                 break;
 
@@ -104,7 +109,7 @@ public:
                     int packets_in_burst = rand() % 5 + 1; // Generate between 1 to 5 packets in a burst
                     for (int i = 0; i < packets_in_burst && packet_count < MAX_PACKETS; ++i) {
                         int queue_index = rand() % 3; // Randomly choose a queue
-                        Packet packet = {packet_count++, queue_index, -1, packet_count, -1}; // Removed priority assignment at arrival
+                        Packet packet = {packet_count++, queue_index, -1, current_time, -1}; // Removed priority assignment at arrival
                         queues[queue_index].enqueue(packet);
                         if (queues[queue_index].is_full()) {
                             total_dropped_packets++; // Increment dropped packet count
@@ -112,6 +117,7 @@ public:
                             std::cout << "Packet " << packet.id << " arrived at Queue " << queue_index << "\n";
                         }
                     }
+                    current_time += rand() % 5 + 1; // the whole burst arrives at once
                 }
                 break;
 
@@ -122,33 +128,46 @@ public:
     }
 
     void request_grant_accept() {
-        while (true) {
-            bool any_packet_processed = false;
-
-            for (int i = 2; i >= 0; --i) {
-                if (!queues[i].is_empty()) {
-                    int packets_to_process = queues[i].weight; // Number of packets to process based on weight
+        // Weighted fair queueing over the three queues: every packet is one
+        // unit long and the output link sends one unit per time step.
+        WfqScheduler wfq(1.0);
+        std::vector<Packet> arrivals;
+        for (int i = 0; i < 3; ++i) {
+            wfq.add_flow(queues[i].weight);
+            while (!queues[i].is_empty()) {
+                arrivals.push_back(queues[i].dequeue());
+            }
+        }
+        std::sort(arrivals.begin(), arrivals.end(), [](const Packet& a, const Packet& b) {
+            return a.arrival_time < b.arrival_time || (a.arrival_time == b.arrival_time && a.id < b.id);
+        });
 
-                    while (packets_to_process > 0 && !queues[i].is_empty()) {
-                        Packet packet = queues[i].dequeue();
+        std::vector<Packet> by_id(packet_count);
+        for (const Packet& packet : arrivals) {
+            by_id[packet.id] = packet;
+        }
 
-                        // Assign priority here if needed
-                        packet.priority = (rand() % 3) + 1; // Assign a random priority to the packet
+        double time = 0;
+        size_t next_arrival = 0;
+        while (next_arrival < arrivals.size() || !wfq.empty()) {
+            if (wfq.empty() && time < arrivals[next_arrival].arrival_time) {
+                time = arrivals[next_arrival].arrival_time; // link idle until next arrival
+            }
+            while (next_arrival < arrivals.size() && arrivals[next_arrival].arrival_time <= time) {
+                const Packet& packet = arrivals[next_arrival++];
+                wfq.enqueue(packet.input_port, 1, packet.arrival_time, packet.id);
+            }
 
-                        packet.processing_time = packet_count; // Set processing time
-                        processed_packets.push_back(packet); // Store processed packet
-                        packets_to_process--;
-                        any_packet_processed = true;
+            WfqPacket sent{};
+            wfq.dequeue(time, sent);
+            time += 1;
 
-                        std::cout << "Packet " << packet.id << " from Queue " << packet.input_port 
-                                  << " granted and accepted with priority " << packet.priority << "\n";
-                    }
-                }
-            }
+            Packet packet = by_id[sent.id];
+            packet.processing_time = static_cast<int>(time); // Set processing time
+            processed_packets.push_back(packet); // Store processed packet
 
-            if (!any_packet_processed) {
-                break;
-            }
+            std::cout << "Packet " << packet.id << " from Queue " << packet.input_port
+                      << " granted and accepted with finish tag " << sent.finish_tag << "\n";
         }
     }
 
@@ -204,7 +223,7 @@ public:
 
         for (const Packet& packet : processed_packets) {
             int turnaround_time = packet.processing_time - packet.arrival_time; // Total time in the system
-            int waiting_time = turnaround_time - (packet.priority); // Adjust based on your logic
+            int waiting_time = turnaround_time - 1; // One unit of transmission time
             
             total_turnaround_time += turnaround_time;
             total_waiting_time += waiting_time;
@@ -0,0 +1,72 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <iomanip>
+#include "voq_switch.h"
+
+// Throughput-vs-load curves for every crossbar arbiter on the VOQ fabric,
+// plus the cost of one match at a large port count.
+// Usage: ./arbiter_bench [ports] [cycles] [pattern] [csv file]
+
+int main(int argc, char* argv[]) {
+    int ports = argc > 1 ? std::stoi(argv[1]) : 32;
+    uint64_t cycles = argc > 2 ? std::stoull(argv[2]) : 20000;
+    std::string pattern = argc > 3 ? argv[3] : "uniform";
+    std::string csv_file = argc > 4 ? argv[4] : "arbiter_curves.csv";
+
+    const ArbiterType arbiters[] = {ARB_ISLIP, ARB_RR, ARB_PIM, ARB_WAVEFRONT, ARB_LQF};
+    const char* names[] = {"islip", "rr", "pim", "wavefront", "lqf"};
+
+    std::ofstream csv(csv_file);
+    csv << "arbiter,pattern,ports,load,throughput,loss_rate,avg_delay\n";
+
+    std::cout << "Throughput (fraction of output capacity), " << ports << " ports, " << pattern << " traffic\n";
+    std::cout << " load";
+    for (const char* name : names) std::cout << std::setw(11) << name;
+    std::cout << "\n";
+
+    for (int step = 1; step <= 10; ++step) {
+        double load = step / 10.0;
+        std::cout << std::fixed << std::setprecision(1) << std::setw(5) << load;
+        for (int a = 0; a < 5; ++a) {
+            VoqConfig config;
+            config.num_ports = ports;
+            config.cycles = cycles;
+            config.arbiter = arbiters[a];
+            config.iterations = arbiters[a] == ARB_PIM ? 4 : 1;
+            parse_traffic(pattern, config.traffic);
+            config.traffic.load = load;
+
+            VoqSwitch fabric(config);
+            fabric.run();
+            const SimStats& stats = fabric.get_stats();
+            std::cout << std::setprecision(4) << std::setw(11) << stats.throughput();
+            csv << names[a] << "," << pattern << "," << ports << "," << load << ","
+                << stats.throughput() << "," << stats.loss_rate() << "," << stats.average_delay() << "\n";
+        }
+        std::cout << "\n";
+    }
+
+    // Match cost at 256 ports under full load.
+    std::cout << "\nCost per cycle at 256 ports, load 1.0 (microseconds)\n";
+    for (int a = 0; a < 5; ++a) {
+        VoqConfig config;
+        config.num_ports = 256;
+        config.cycles = 2000;
+        config.arbiter = arbiters[a];
+        config.iterations = arbiters[a] == ARB_PIM ? 4 : 1;
+        config.traffic.load = 1.0;
+        VoqSwitch fabric(config);
+        auto start = std::chrono::steady_clock::now();
+        fabric.run();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << std::setw(11) << names[a] << std::setprecision(2) << std::setw(10)
+                  << seconds * 1e6 / config.cycles << "   (throughput "
+                  << std::setprecision(4) << fabric.get_stats().throughput() << ")\n";
+    }
+
+    std::cout << "\nCurves written to " << csv_file << "\n";
+    return 0;
+}
@@ -0,0 +1,405 @@
+#ifndef ARBITERS_H
+#define ARBITERS_H
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "rng.h"
+
+// Crossbar arbiters for a switch with virtual output queues (VOQs). The
+// request state is kept as bit matrices so every arbiter works a 64-bit word
+// at a time: a 256-port match touches a few thousand words, not 65536 cells.
+
+// N x N bit matrix, row-major, `words` 64-bit words per row.
+class BitMatrix {
+public:
+    void reset(int size) {
+        n = size;
+        words = (size + 63) / 64;
+        bits.assign(static_cast<size_t>(n) * words, 0);
+    }
+
+    uint64_t* row(int r) { return &bits[static_cast<size_t>(r) * words]; }
+    const uint64_t* row(int r) const { return &bits[static_cast<size_t>(r) * words]; }
+
+    void set(int r, int c) { row(r)[c >> 6] |= uint64_t(1) << (c & 63); }
+    void clear(int r, int c) { row(r)[c >> 6] &= ~(uint64_t(1) << (c & 63)); }
+    bool test(int r, int c) const { return (row(r)[c >> 6] >> (c & 63)) & 1; }
+
+    void clear_all() { std::fill(bits.begin(), bits.end(), 0); }
+
+    int n = 0;
+    int words = 0;
+
+private:
+    std::vector<uint64_t> bits;
+};
+
+// --- word-level bitset helpers -------------------------------------------
+
+inline void bits_and(const uint64_t* a, const uint64_t* b, uint64_t* out, int words) {
+    for (int w = 0; w < words; ++w) out[w] = a[w] & b[w];
+}
+
+inline bool bits_any(const uint64_t* a, int words) {
+    for (int w = 0; w < words; ++w) {
+        if (a[w]) return true;
+    }
+    return false;
+}
+
+inline int bits_count(const uint64_t* a, int words) {
+    int count = 0;
+    for (int w = 0; w < words; ++w) count += __builtin_popcountll(a[w]);
+    return count;
+}
+
+// First set bit at or after `start`, wrapping around at n; -1 if none.
+inline int bits_find_wrapped(const uint64_t* a, int words, int start) {
+    int w = start >> 6;
+    uint64_t first = a[w] & (~uint64_t(0) << (start & 63));
+    if (first) return (w << 6) + __builtin_ctzll(first);
+    for (int k = 1; k <= words; ++k) {
+        int idx = (w + k) % words;
+        uint64_t word = idx == w ? a[w] & ~(~uint64_t(0) << (start & 63)) : a[idx];
+        if (word) return (idx << 6) + __builtin_ctzll(word);
+    }
+    return -1;
+}
+
+// Index of the r-th set bit (0-based); r must be < bits_count.
+inline int bits_select(const uint64_t* a, int words, int r) {
+    for (int w = 0; w < words; ++w) {
+        int count = __builtin_popcountll(a[w]);
+        if (r < count) {
+            uint64_t word = a[w];
+            for (int k = 0; k < r; ++k) word &= word - 1; // drop lowest set bits
+            return (w << 6) + __builtin_ctzll(word);
+        }
+        r -= count;
+    }
+    return -1;
+}
+
+// out[i] = a[(i + k) mod n] for an n-bit set: rotates bit (i + k) down to i.
+inline void bits_rotate(const uint64_t* a, int n, int k, uint64_t* out) {
+    int words = (n + 63) / 64;
+    for (int w = 0; w < words; ++w) out[w] = 0;
+    // Copy in two runs, [k, n) to [0, n - k) and [0, k) to [n - k, n), using
+    // word-sized chunks where the source and destination allow.
+    auto copy_run = [&](int src, int dst, int len) {
+        while (len > 0) {
+            int src_off = src & 63, dst_off = dst & 63;
+            int chunk = 64 - (src_off > dst_off ? src_off : dst_off);
+            if (chunk > len) chunk = len;
+            uint64_t piece = a[src >> 6] >> src_off;
+            if (chunk < 64) piece &= (uint64_t(1) << chunk) - 1;
+            out[dst >> 6] |= piece << dst_off;
+            src += chunk;
+            dst += chunk;
+            len -= chunk;
+        }
+    };
+    copy_run(k, 0, n - k);
+    copy_run(0, n - k, k);
+}
+
+// Which VOQs are non-empty, seen by input, by output and by wrapped diagonal,
+// plus the VOQ lengths for weight-based arbiters. Maintained incrementally
+// by the switch as VOQs become empty or non-empty.
+struct RequestMatrix {
+    void reset(int size) {
+        n = size;
+        words = (size + 63) / 64;
+        by_input.reset(size);
+        by_output.reset(size);
+        by_diagonal.reset(size);
+        length.assign(static_cast<size_t>(size) * size, 0);
+    }
+
+    void set(int input, int output) {
+        by_input.set(input, output);
+        by_output.set(output, input);
+        by_diagonal.set(diagonal(input, output), input);
+    }
+
+    void clear(int input, int output) {
+        by_input.clear(input, output);
+        by_output.clear(output, input);
+        by_diagonal.clear(diagonal(input, output), input);
+    }
+
+    int diagonal(int input, int output) const {
+        int d = output - input;
+        return d < 0 ? d + n : d;
+    }
+
+    int n = 0;
+    int words = 0;
+    BitMatrix by_input;    // row i, bit j: VOQ(i, j) non-empty
+    BitMatrix by_output;   // row j, bit i
+    BitMatrix by_diagonal; // row d, bit i: VOQ(i, (i + d) mod n) non-empty
+    std::vector<uint16_t> length; // VOQ(i, j) occupancy at [i * n + j]
+};
+
+class Arbiter {
+public:
+    virtual ~Arbiter() = default;
+
+    // Fills match[i] with the output given to input i, or -1.
+    virtual void match(const RequestMatrix& requests, std::vector<int>& match, CounterRng& gen) = 0;
+    virtual const char* name() const = 0;
+};
+
+// Shared request-grant-accept loop for iSLIP, round-robin matching and PIM.
+// Subclasses choose how an output picks among requesting inputs and how an
+// input picks among its grants.
+class RequestGrantAccept : public Arbiter {
+public:
+    RequestGrantAccept(int n, int iterations) : n(n), words((n + 63) / 64), iterations(iterations) {
+        grants.reset(n);
+        free_inputs.resize(words);
+        free_outputs.resize(words);
+        granted_inputs.resize(words);
+        scratch.resize(words);
+    }
+
+    void match(const RequestMatrix& requests, std::vector<int>& match, CounterRng& gen) override {
+        match.assign(n, -1);
+        set_all(free_inputs);
+        set_all(free_outputs);
+
+        for (int iteration = 0; iteration < iterations; ++iteration) {
+            grants.clear_all();
+            std::fill(granted_inputs.begin(), granted_inputs.end(), 0);
+            bool any = false;
+
+            // Grant: each unmatched output picks one unmatched requester.
+            for (int w = 0; w < words; ++w) {
+                for (uint64_t out_bits = free_outputs[w]; out_bits; out_bits &= out_bits - 1) {
+                    int output = (w << 6) + __builtin_ctzll(out_bits);
+                    bits_and(requests.by_output.row(output), free_inputs.data(), scratch.data(), words);
+                    if (!bits_any(scratch.data(), words)) continue;
+                    int input = pick_grant(output, scratch.data(), gen);
+                    grants.set(input, output);
+                    granted_inputs[input >> 6] |= uint64_t(1) << (input & 63);
+                    any = true;
+                }
+            }
+            if (!any) break;
+
+            // Accept: each input that received grants keeps one of them.
+            for (int w = 0; w < words; ++w) {
+                for (uint64_t in_bits = granted_inputs[w]; in_bits; in_bits &= in_bits - 1) {
+                    int input = (w << 6) + __builtin_ctzll(in_bits);
+                    int output = pick_accept(input, grants.row(input), gen);
+                    match[input] = output;
+                    free_inputs[input >> 6] &= ~(uint64_t(1) << (input & 63));
+                    free_outputs[output >> 6] &= ~(uint64_t(1) << (output & 63));
+                    on_accept(input, output, iteration);
+                }
+            }
+        }
+    }
+
+protected:
+    virtual int pick_grant(int output, const uint64_t* candidates, CounterRng& gen) = 0;
+    virtual int pick_accept(int input, const uint64_t* grants_row, CounterRng& gen) = 0;
+    virtual void on_accept(int, int, int) {}
+
+    void set_all(std::vector<uint64_t>& set) const {
+        std::fill(set.begin(), set.end(), ~uint64_t(0));
+        if (n & 63) set[words - 1] = (uint64_t(1) << (n & 63)) - 1;
+    }
+
+    int n;
+    int words;
+    int iterations;
+    BitMatrix grants; // row i: outputs that granted input i this iteration
+    std::vector<uint64_t> free_inputs, free_outputs, granted_inputs, scratch;
+};
+
+// iSLIP: round-robin grant and accept pointers that move one past the
+// partner only when a grant is accepted in the first iteration.
+class ISlipArbiter : public RequestGrantAccept {
+public:
+    ISlipArbiter(int n, int iterations)
+        : RequestGrantAccept(n, iterations), grant_pointer(n, 0), accept_pointer(n, 0) {}
+
+    const char* name() const override { return "islip"; }
+
+protected:
+    int pick_grant(int output, const uint64_t* candidates, CounterRng&) override {
+        return bits_find_wrapped(candidates, words, grant_pointer[output]);
+    }
+
+    int pick_accept(int input, const uint64_t* grants_row, CounterRng&) override {
+        return bits_find_wrapped(grants_row, words, accept_pointer[input]);
+    }
+
+    void on_accept(int input, int output, int iteration) override {
+        if (iteration != 0) return;
+        grant_pointer[output] = input + 1 == n ? 0 : input + 1;
+        accept_pointer[input] = output + 1 == n ? 0 : output + 1;
+    }
+
+    std::vector<int> grant_pointer, accept_pointer;
+};
+
+// Round-robin matching (the pre-iSLIP scheme behind RoundRobin.cpp): grant
+// pointers move past the granted input whether or not it accepts, which lets
+// outputs synchronize and caps throughput near 63% under uniform load.
+class RoundRobinArbiter : public ISlipArbiter {
+public:
+    RoundRobinArbiter(int n) : ISlipArbiter(n, 1) {}
+
+    const char* name() const override { return "rr"; }
+
+protected:
+    int pick_grant(int output, const uint64_t* candidates, CounterRng& gen) override {
+        int input = ISlipArbiter::pick_grant(output, candidates, gen);
+        grant_pointer[output] = input + 1 == n ? 0 : input + 1;
+        return input;
+    }
+
+    void on_accept(int input, int output, int) override {
+        accept_pointer[input] = output + 1 == n ? 0 : output + 1;
+    }
+};
+
+// Parallel iterative matching: outputs grant and inputs accept uniformly at
+// random among their candidates.
+class PimArbiter : public RequestGrantAccept {
+public:
+    PimArbiter(int n, int iterations) : RequestGrantAccept(n, iterations) {}
+
+    const char* name() const override { return "pim"; }
+
+protected:
+    int pick_grant(int, const uint64_t* candidates, CounterRng& gen) override {
+        return bits_select(candidates, words, gen.bounded(bits_count(candidates, words)));
+    }
+
+    int pick_accept(int, const uint64_t* grants_row, CounterRng& gen) override {
+        return bits_select(grants_row, words, gen.bounded(bits_count(grants_row, words)));
+    }
+};
+
+// Wrapped wavefront arbiter: the cells of one wrapped diagonal never share a
+// row or column, so a whole diagonal is decided at once. Diagonals are swept
+// starting from one that rotates every cycle for fairness. Each diagonal is
+// an AND of three bitsets, so a match costs O(n * n / 64) word operations.
+class WavefrontArbiter : public Arbiter {
+public:
+    explicit WavefrontArbiter(int n)
+        : n(n), words((n + 63) / 64), free_inputs(words), free_outputs(words),
+          rotated(words), candidates(words) {}
+
+    const char* name() const override { return "wavefront"; }
+
+    void match(const RequestMatrix& requests, std::vector<int>& match, CounterRng&) override {
+        match.assign(n, -1);
+        std::fill(free_inputs.begin(), free_inputs.end(), ~uint64_t(0));
+        std::fill(free_outputs.begin(), free_outputs.end(), ~uint64_t(0));
+        if (n & 63) {
+            free_inputs[words - 1] = (uint64_t(1) << (n & 63)) - 1;
+            free_outputs[words - 1] = free_inputs[words - 1];
+        }
+
+        for (int step = 0; step < n; ++step) {
+            int d = start + step < n ? start + step : start + step - n;
+            // Input i on diagonal d wants output (i + d) mod n.
+            bits_rotate(free_outputs.data(), n, d, rotated.data());
+            const uint64_t* diagonal = requests.by_diagonal.row(d);
+            bool any = false;
+            for (int w = 0; w < words; ++w) {
+                candidates[w] = diagonal[w] & free_inputs[w] & rotated[w];
+                any |= candidates[w] != 0;
+            }
+            if (!any) continue;
+            for (int w = 0; w < words; ++w) {
+                free_inputs[w] &= ~candidates[w];
+                for (uint64_t bits = candidates[w]; bits; bits &= bits - 1) {
+                    int input = (w << 6) + __builtin_ctzll(bits);
+                    int output = input + d < n ? input + d : input + d - n;
+                    match[input] = output;
+                    free_outputs[output >> 6] &= ~(uint64_t(1) << (output & 63));
+                }
+            }
+        }
+        start = start + 1 == n ? 0 : start + 1;
+    }
+
+private:
+    int n;
+    int words;
+    int start = 0;
+    std::vector<uint64_t> free_inputs, free_outputs, rotated, candidates;
+};
+
+// Longest-queue-first: greedy maximum-weight matching with VOQ length as the
+// weight. VOQs are bucket-sorted by length (lengths are bounded by the VOQ
+// limit), then taken longest first whenever both ports are still free.
+class LqfArbiter : public Arbiter {
+public:
+    LqfArbiter(int n, int max_length) : n(n), buckets(max_length + 1) {}
+
+    const char* name() const override { return "lqf"; }
+
+    void match(const RequestMatrix& requests, std::vector<int>& match, CounterRng&) override {
+        match.assign(n, -1);
+        for (std::vector<uint32_t>& bucket : buckets) bucket.clear();
+        for (int input = 0; input < n; ++input) {
+            const uint64_t* row = requests.by_input.row(input);
+            for (int w = 0; w < requests.words; ++w) {
+                for (uint64_t bits = row[w]; bits; bits &= bits - 1) {
+                    int output = (w << 6) + __builtin_ctzll(bits);
+                    int len = requests.length[static_cast<size_t>(input) * n + output];
+                    if (len >= static_cast<int>(buckets.size())) len = static_cast<int>(buckets.size()) - 1;
+                    buckets[len].push_back(static_cast<uint32_t>(input) * n + output);
+                }
+            }
+        }
+        output_taken.assign(n, 0);
+        for (int len = static_cast<int>(buckets.size()) - 1; len > 0; --len) {
+            for (uint32_t voq : buckets[len]) {
+                int input = voq / n, output = voq % n;
+                if (match[input] == -1 && !output_taken[output]) {
+                    match[input] = output;
+                    output_taken[output] = 1;
+                }
+            }
+        }
+    }
+
+private:
+    int n;
+    std::vector<std::vector<uint32_t>> buckets; // capacity is kept between cycles
+    std::vector<uint8_t> output_taken;
+};
+
+enum ArbiterType { ARB_ISLIP, ARB_RR, ARB_PIM, ARB_WAVEFRONT, ARB_LQF };
+
+inline std::unique_ptr<Arbiter> make_arbiter(ArbiterType type, int n, int iterations, int max_length) {
+    switch (type) {
+        case ARB_RR: return std::unique_ptr<Arbiter>(new RoundRobinArbiter(n));
+        case ARB_PIM: return std::unique_ptr<Arbiter>(new PimArbiter(n, iterations));
+        case ARB_WAVEFRONT: return std::unique_ptr<Arbiter>(new WavefrontArbiter(n));
+        case ARB_LQF: return std::unique_ptr<Arbiter>(new LqfArbiter(n, max_length));
+        default: return std::unique_ptr<Arbiter>(new ISlipArbiter(n, iterations));
+    }
+}
+
+inline bool parse_arbiter(const std::string& name, ArbiterType& out) {
+    if (name == "islip") out = ARB_ISLIP;
+    else if (name == "rr") out = ARB_RR;
+    else if (name == "pim") out = ARB_PIM;
+    else if (name == "wavefront") out = ARB_WAVEFRONT;
+    else if (name == "lqf") out = ARB_LQF;
+    else return false;
+    return true;
+}
+
+#endif
@@ -0,0 +1,108 @@
+#include <iostream>
+#include <string>
+#include <functional>
+#include <iomanip>
+#include "cioq_switch.h"
+#include "shared_buffer_switch.h"
+
+// How much buffer memory each switch design needs to hold the loss rate at
+// or below a target: CIOQ with speedup 1 to 4 against a shared-memory
+// output-queued switch under static, complete and dynamic-threshold sharing.
+// The buffer size is found by binary search on the loss rate of full runs.
+// Usage: ./buffer_bench [ports] [cycles] [load] [target loss] [pattern] [max speedup]
+
+constexpr int MAX_SEARCH = 4096;
+
+// Smallest size in [1, limit] whose loss rate is <= target, or -1.
+int smallest_buffer(int limit, double target, const std::function<double(int)>& loss_at) {
+    if (loss_at(limit) > target) return -1;
+    int lo = 1, hi = limit;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (loss_at(mid) <= target) hi = mid;
+        else lo = mid + 1;
+    }
+    return lo;
+}
+
+// `total` is the whole switch's buffer in packets, -1 if the search failed.
+void print_row(const std::string& design, long long total, int ports) {
+    std::cout << std::left << std::setw(24) << design << std::right;
+    if (total < 0) {
+        std::cout << std::setw(12) << "> limit" << "\n";
+        return;
+    }
+    std::cout << std::setw(12) << (total + ports - 1) / ports << std::setw(14) << total << "\n";
+}
+
+int main(int argc, char* argv[]) {
+    int ports = argc > 1 ? std::stoi(argv[1]) : 16;
+    uint64_t cycles = argc > 2 ? std::stoull(argv[2]) : 50000;
+    double load = argc > 3 ? std::stod(argv[3]) : 0.9;
+    double target = argc > 4 ? std::stod(argv[4]) : 1e-3;
+    std::string pattern = argc > 5 ? argv[5] : "bursty";
+    int max_speedup = argc > 6 ? std::stoi(argv[6]) : 4;
+    if (max_speedup < 1 || max_speedup > 4) {
+        std::cerr << "Speedup must be 1 to 4, not " << max_speedup << "\n";
+        return 1;
+    }
+
+    TrafficConfig traffic;
+    if (!parse_traffic(pattern, traffic)) {
+        std::cerr << "Unknown pattern: " << pattern << "\n";
+        return 1;
+    }
+    traffic.load = load;
+
+    std::cout << "Buffer needed for loss <= " << target << ", " << ports << " ports, "
+              << pattern << " traffic, load " << load << "\n";
+    std::cout << std::left << std::setw(24) << "design" << std::right
+              << std::setw(12) << "per port" << std::setw(14) << "total pkts" << "\n";
+
+    // CIOQ: b packets per input (any VOQ may use all of them) and, once the
+    // fabric is faster than the line, b packets per output queue as well.
+    for (int speedup = 1; speedup <= max_speedup; ++speedup) {
+        auto output_size = [&](int b) { return speedup == 1 ? 1 : b; };
+        int b = smallest_buffer(MAX_SEARCH / 4, target, [&](int size) {
+            CioqConfig config;
+            config.num_ports = ports;
+            config.speedup = speedup;
+            config.voq_limit = size;
+            config.input_buffer = size;
+            config.output_buffer = output_size(size);
+            config.cycles = cycles;
+            config.traffic = traffic;
+            CioqSwitch fabric(config);
+            fabric.run();
+            return fabric.get_stats().loss_rate();
+        });
+        print_row("cioq islip x" + std::to_string(speedup),
+                  b < 0 ? -1 : static_cast<long long>(ports) * (b + output_size(b)), ports);
+    }
+
+    // Shared memory: search the total buffer directly.
+    struct Policy { const char* name; BufferPolicy policy; double alpha; };
+    const Policy policies[] = {
+        {"shared static", BUFFER_STATIC, 0},
+        {"shared complete", BUFFER_COMPLETE, 0},
+        {"shared dynamic a=0.5", BUFFER_DYNAMIC, 0.5},
+        {"shared dynamic a=1", BUFFER_DYNAMIC, 1.0},
+        {"shared dynamic a=2", BUFFER_DYNAMIC, 2.0},
+    };
+    for (const Policy& p : policies) {
+        int total = smallest_buffer(MAX_SEARCH * 4, target, [&](int size) {
+            SharedBufferConfig config;
+            config.num_ports = ports;
+            config.buffer_size = size;
+            config.policy = p.policy;
+            config.alpha = p.alpha;
+            config.cycles = cycles;
+            config.traffic = traffic;
+            SharedBufferSwitch fabric(config);
+            fabric.run();
+            return fabric.get_stats().loss_rate();
+        });
+        print_row(p.name, total, ports);
+    }
+    return 0;
+}
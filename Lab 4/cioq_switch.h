@@ -0,0 +1,142 @@
+#ifndef CIOQ_SWITCH_H
+#define CIOQ_SWITCH_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "arbiters.h"
+#include "packet_pool.h"
+#include "rng.h"
+#include "sim_stats.h"
+#include "traffic.h"
+
+// Combined input/output queued switch. Inputs hold VOQs as in voq_switch.h,
+// but the fabric runs `speedup` matching phases per cycle and delivers into
+// output queues, each of which sends one packet per cycle. iSLIP.cpp,
+// RoundRobin.cpp and priority.cpp are the speedup-1 case. An output whose
+// queue is full is hidden from the arbiter until it drains (backpressure),
+// so packets are only ever lost at the inputs.
+
+struct CioqConfig {
+    int num_ports = 32;
+    int speedup = 1;            // matching phases per cycle, 1 to 4
+    int voq_limit = 64;         // packets per VOQ
+    int input_buffer = 256;     // packets per input across all of its VOQs
+    int output_buffer = 64;     // packets per output queue
+    ArbiterType arbiter = ARB_ISLIP;
+    int iterations = 1;         // for iSLIP and PIM
+    uint64_t cycles = 100000;
+    uint64_t seed = 1;
+    uint64_t stream = 0;
+    TrafficConfig traffic;
+};
+
+struct CioqPacket {
+    uint32_t arrival_time;
+    uint32_t traffic_class;
+};
+
+class CioqSwitch {
+public:
+    explicit CioqSwitch(const CioqConfig& config)
+        : config(config), n(config.num_ports), stats(config.num_ports, config.traffic.num_classes),
+          traffic(config.traffic, config.num_ports, config.seed, config.stream),
+          arbiter_rng(config.seed, config.stream ^ 0x5a5a5a5a5a5a5a5aULL),
+          pool(static_cast<uint32_t>(config.num_ports) * (config.input_buffer + config.output_buffer)),
+          voqs(static_cast<size_t>(config.num_ports) * config.num_ports, RingQueue(config.voq_limit)),
+          output_queues(config.num_ports, RingQueue(config.output_buffer)),
+          input_occupancy(config.num_ports, 0) {
+        requests.reset(n);
+        arbiter = make_arbiter(config.arbiter, n, config.iterations, config.voq_limit);
+    }
+
+    void run() {
+        for (uint64_t cycle = 0; cycle < config.cycles; ++cycle) {
+            step(cycle);
+        }
+        stats.cycles += config.cycles;
+    }
+
+    const SimStats& get_stats() const { return stats; }
+    const char* arbiter_name() const { return arbiter->name(); }
+
+private:
+    void step(uint64_t cycle) {
+        traffic.generate(cycle, [&](int input, int output, int traffic_class) {
+            enqueue(input, output, traffic_class, cycle);
+        });
+
+        for (int phase = 0; phase < config.speedup; ++phase) {
+            arbiter->match(requests, matching, arbiter_rng);
+            bool moved = false;
+            for (int input = 0; input < n; ++input) {
+                int output = matching[input];
+                if (output < 0) continue;
+                size_t index = static_cast<size_t>(input) * n + output;
+                output_queues[output].push(voqs[index].pop());
+                if (--requests.length[index] == 0) requests.clear(input, output);
+                input_occupancy[input]--;
+                if (output_queues[output].full()) block_output(output);
+                moved = true;
+            }
+            if (!moved) break;
+        }
+
+        for (int output = 0; output < n; ++output) {
+            RingQueue& queue = output_queues[output];
+            if (queue.empty()) continue;
+            bool was_full = queue.full();
+            PacketHandle handle = queue.pop();
+            stats.record_departure(output, cycle - pool[handle].arrival_time, pool[handle].traffic_class);
+            pool.release(handle);
+            if (was_full) unblock_output(output);
+        }
+    }
+
+    void enqueue(int input, int output, int traffic_class, uint64_t cycle) {
+        stats.generated++;
+        size_t index = static_cast<size_t>(input) * n + output;
+        if (input_occupancy[input] >= config.input_buffer || voqs[index].full()) {
+            stats.record_drop(input);
+            return;
+        }
+        PacketHandle handle = pool.allocate();
+        pool[handle] = CioqPacket{static_cast<uint32_t>(cycle), static_cast<uint32_t>(traffic_class)};
+        voqs[index].push(handle);
+        input_occupancy[input]++;
+        if (requests.length[index]++ == 0 && !output_queues[output].full()) requests.set(input, output);
+    }
+
+    // Withdraw every request for a full output; lengths are kept so the
+    // requests can be restored when it drains.
+    void block_output(int output) {
+        const uint64_t* row = requests.by_output.row(output);
+        for (int w = 0; w < requests.words; ++w) {
+            for (uint64_t bits = row[w]; bits; bits &= bits - 1) {
+                int input = (w << 6) + __builtin_ctzll(bits);
+                requests.clear(input, output);
+            }
+        }
+    }
+
+    void unblock_output(int output) {
+        for (int input = 0; input < n; ++input) {
+            if (requests.length[static_cast<size_t>(input) * n + output]) requests.set(input, output);
+        }
+    }
+
+    CioqConfig config;
+    int n;
+    SimStats stats;
+    TrafficGenerator traffic;
+    CounterRng arbiter_rng; // separate stream so arbiters never perturb arrivals
+    PacketPool<CioqPacket> pool;
+    std::vector<RingQueue> voqs;
+    std::vector<RingQueue> output_queues;
+    std::vector<int> input_occupancy;
+    RequestMatrix requests;
+    std::unique_ptr<Arbiter> arbiter;
+    std::vector<int> matching;
+};
+
+#endif
@@ -0,0 +1,349 @@
+#ifndef FABRIC_NETWORK_H
+#define FABRIC_NETWORK_H
+
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <string>
+#include <vector>
+#include "arbiters.h"
+#include "fabric_topology.h"
+#include "packet_pool.h"
+#include "rng.h"
+#include "sim_stats.h"
+
+// Packet-level simulator for a fabric of VOQ crossbar switches wired by
+// fabric_topology.h. Each switch runs one of the arbiters from arbiters.h
+// every cycle it has work; every link has a delay in cycles and carries one
+// packet per cycle.
+//
+// Backpressure is credit based: a switch output holds one credit per free
+// slot in the input buffer at the far end of its link. Sending spends a
+// credit; the credit travels back over the link when the packet leaves that
+// buffer. An output without credits is hidden from the arbiter, so packets
+// are never dropped inside the fabric, only at a host whose queue is full.
+//
+// The core is event driven: host arrivals (geometric gaps), packets on links
+// and returning credits are timed events, and a cycle only touches switches
+// and hosts that hold packets. When nothing is queued the clock jumps to the
+// next event, so a large, lightly loaded fabric costs little per cycle.
+// Link events are at most max(link_delay, host_delay) cycles ahead and sit in
+// a timing wheel; only host arrivals, which can be far off, use a heap.
+
+enum FabricPattern { FABRIC_UNIFORM, FABRIC_PERMUTATION };
+
+struct FabricConfig {
+    ArbiterType arbiter = ARB_ISLIP;
+    int iterations = 1;         // for iSLIP and PIM
+    int port_buffer = 16;       // packets per switch input, i.e. credits per link
+    int host_queue = 64;        // packets a host holds while waiting for credits
+    int link_delay = 1;         // cycles per switch-to-switch hop (>= 1)
+    int host_delay = 1;         // cycles on host links (>= 1)
+    double load = 0.5;          // packets per host per cycle
+    FabricPattern pattern = FABRIC_UNIFORM;
+    uint64_t cycles = 100000;
+    uint64_t seed = 1;
+    uint64_t stream = 0;
+};
+
+struct FabricPacket {
+    uint32_t birth;
+    int dst;
+    uint32_t flow_hash;
+};
+
+class FabricNetwork {
+public:
+    FabricNetwork(const FabricTopology& topology, const FabricConfig& config)
+        : topology(topology), config(config), stats(topology.num_hosts),
+          gen(config.seed, config.stream), arbiter_rng(config.seed, config.stream ^ 0x5a5a5a5a5a5a5a5aULL),
+          pool(pool_capacity(topology, config)) {
+        uint32_t span = 1;
+        int max_delay = config.link_delay > config.host_delay ? config.link_delay : config.host_delay;
+        while (span <= static_cast<uint32_t>(max_delay)) span <<= 1;
+        wheel.resize(span);
+        wheel_mask = span - 1;
+        for (int sw = 0; sw < topology.num_switches(); ++sw) {
+            int ports = topology.radix[sw];
+            switches.emplace_back();
+            SwitchState& s = switches.back();
+            s.voqs.assign(static_cast<size_t>(ports) * ports, RingQueue(config.port_buffer));
+            s.input_occupancy.assign(ports, 0);
+            s.credits.resize(ports);
+            for (int port = 0; port < ports; ++port) {
+                const PortRef& down = topology.out_link[sw][port];
+                // Hosts always sink; unconnected ports never get a request.
+                s.credits[port] = down.is_host() ? INT32_MAX / 2 : config.port_buffer;
+            }
+            s.requests.reset(ports);
+            s.arbiter = make_arbiter(config.arbiter, ports, config.iterations, config.port_buffer);
+        }
+        hosts.resize(topology.num_hosts);
+        for (HostState& h : hosts) {
+            h.queue.reset(config.host_queue);
+            h.credits = config.port_buffer;
+        }
+        if (config.load >= 1.0) log_idle = 0;
+        else if (config.load > 0.0) log_idle = std::log(1.0 - config.load);
+        for (int h = 0; h < topology.num_hosts; ++h) schedule_generation(h, 0);
+    }
+
+    void run() {
+        uint64_t now = 0;
+        while (now < config.cycles) {
+            std::vector<Event>& bucket = wheel[now & wheel_mask];
+            for (const Event& e : bucket) handle(e, now);
+            wheel_count -= bucket.size();
+            bucket.clear();
+            while (!arrivals.empty() && arrivals.top().time <= now) {
+                Event e = arrivals.top();
+                arrivals.pop();
+                handle(e, now);
+            }
+            step_hosts(now);
+            step_switches(now);
+
+            if (active_hosts.empty() && active_switches.empty() && wheel_count == 0) {
+                if (arrivals.empty()) break;
+                uint64_t next = arrivals.top().time;
+                if (next > now + 1) {
+                    skipped_cycles += (next < config.cycles ? next : config.cycles) - now - 1;
+                    now = next;
+                    continue;
+                }
+            }
+            now++;
+        }
+        stats.cycles += config.cycles;
+    }
+
+    const SimStats& get_stats() const { return stats; }
+    uint64_t get_switch_steps() const { return switch_steps; }   // switch-cycles actually simulated
+    uint64_t get_skipped_cycles() const { return skipped_cycles; }
+    uint64_t get_events() const { return event_count; }
+
+private:
+    enum EventType : uint8_t { EV_GENERATE, EV_ARRIVE, EV_CREDIT };
+
+    struct Event {
+        uint64_t time;
+        uint64_t seq; // heap ties resolve in scheduling order, so runs are reproducible
+        EventType type;
+        int node;
+        int port;
+        PacketHandle packet;
+
+        bool operator>(const Event& other) const {
+            return time != other.time ? time > other.time : seq > other.seq;
+        }
+    };
+
+    struct SwitchState {
+        std::vector<RingQueue> voqs; // [input * radix + output]
+        std::vector<int> input_occupancy;
+        std::vector<int> credits;
+        RequestMatrix requests;
+        std::unique_ptr<Arbiter> arbiter;
+        std::vector<int> matching;
+        int queued = 0;
+        bool active = false;
+    };
+
+    struct HostState {
+        RingQueue queue;
+        int credits = 0;
+        bool active = false;
+    };
+
+    static uint32_t pool_capacity(const FabricTopology& topology, const FabricConfig& config) {
+        uint64_t ports = 0;
+        for (int r : topology.radix) ports += r;
+        return static_cast<uint32_t>(ports * config.port_buffer +
+                                     static_cast<uint64_t>(topology.num_hosts) * config.host_queue);
+    }
+
+    // Link events; `time` is within the wheel span of now.
+    void schedule(uint64_t time, EventType type, int node, int port, PacketHandle packet = NULL_HANDLE) {
+        wheel[time & wheel_mask].push_back(Event{time, 0, type, node, port, packet});
+        wheel_count++;
+    }
+
+    // Bernoulli(load) arrivals per cycle, sampled as geometric gaps.
+    void schedule_generation(int host, uint64_t after) {
+        if (config.load <= 0.0) return;
+        uint64_t gap = 0;
+        if (log_idle < 0) gap = static_cast<uint64_t>(std::log(1.0 - gen.uniform()) / log_idle);
+        arrivals.push(Event{after + gap, next_seq++, EV_GENERATE, host, 0, NULL_HANDLE});
+    }
+
+    void handle(const Event& e, uint64_t now) {
+        event_count++;
+        switch (e.type) {
+            case EV_GENERATE: generate(e.node, now); break;
+            case EV_ARRIVE: arrive(e.node, e.port, e.packet); break;
+            case EV_CREDIT: credit(e.node, e.port); break;
+        }
+    }
+
+    void generate(int src, uint64_t now) {
+        schedule_generation(src, now + 1);
+        stats.generated++;
+        HostState& h = hosts[src];
+        if (h.queue.full()) {
+            stats.record_drop(src);
+            return;
+        }
+        int num_hosts = topology.num_hosts;
+        int dst;
+        if (config.pattern == FABRIC_PERMUTATION) {
+            dst = (src + num_hosts / 2) % num_hosts;
+        } else {
+            // Any host but src; callers build topologies with >= 2 hosts
+            dst = static_cast<int>(gen.bounded(num_hosts - 1));
+            if (dst >= src) dst++;
+        }
+        PacketHandle handle = pool.allocate();
+        pool[handle] = FabricPacket{static_cast<uint32_t>(now), dst, flow_hash(src, dst)};
+        h.queue.push(handle);
+        activate_host(src);
+    }
+
+    void arrive(int sw, int input, PacketHandle handle) {
+        SwitchState& s = switches[sw];
+        int ports = topology.radix[sw];
+        const FabricPacket& packet = pool[handle];
+        int output = topology.route(sw, packet.dst, packet.flow_hash);
+        size_t index = static_cast<size_t>(input) * ports + output;
+        s.voqs[index].push(handle); // credits guarantee room
+        s.input_occupancy[input]++;
+        s.queued++;
+        if (s.requests.length[index]++ == 0 && s.credits[output] > 0) s.requests.set(input, output);
+        if (!s.active) {
+            s.active = true;
+            active_switches.push_back(sw);
+        }
+    }
+
+    void credit(int node, int port) {
+        if (node < 0) {
+            int host = -node - 1;
+            hosts[host].credits++;
+            if (!hosts[host].queue.empty()) activate_host(host);
+            return;
+        }
+        SwitchState& s = switches[node];
+        if (s.credits[port]++ == 0) {
+            int ports = topology.radix[node];
+            for (int input = 0; input < ports; ++input) {
+                if (s.requests.length[static_cast<size_t>(input) * ports + port]) s.requests.set(input, port);
+            }
+        }
+    }
+
+    void activate_host(int host) {
+        HostState& h = hosts[host];
+        if (h.active || h.credits == 0) return;
+        h.active = true;
+        active_hosts.push_back(host);
+    }
+
+    void step_hosts(uint64_t now) {
+        size_t kept = 0;
+        for (size_t i = 0; i < active_hosts.size(); ++i) {
+            int host = active_hosts[i];
+            HostState& h = hosts[host];
+            const PortRef& up = topology.host_uplink[host];
+            schedule(now + config.host_delay, EV_ARRIVE, up.node, up.port, h.queue.pop());
+            h.credits--;
+            if (!h.queue.empty() && h.credits > 0) active_hosts[kept++] = host;
+            else h.active = false;
+        }
+        active_hosts.resize(kept);
+    }
+
+    void step_switches(uint64_t now) {
+        size_t kept = 0;
+        for (size_t i = 0; i < active_switches.size(); ++i) {
+            int sw = active_switches[i];
+            step_switch(sw, now);
+            if (switches[sw].queued > 0) active_switches[kept++] = sw;
+            else switches[sw].active = false;
+        }
+        active_switches.resize(kept);
+    }
+
+    void step_switch(int sw, uint64_t now) {
+        switch_steps++;
+        SwitchState& s = switches[sw];
+        int ports = topology.radix[sw];
+        s.arbiter->match(s.requests, s.matching, arbiter_rng);
+        for (int input = 0; input < ports; ++input) {
+            int output = s.matching[input];
+            if (output < 0) continue;
+            size_t index = static_cast<size_t>(input) * ports + output;
+            PacketHandle handle = s.voqs[index].pop();
+            if (--s.requests.length[index] == 0) s.requests.clear(input, output);
+            s.input_occupancy[input]--;
+            s.queued--;
+
+            const PortRef& up = topology.in_link[sw][input];
+            schedule(now + (up.is_host() ? config.host_delay : config.link_delay), EV_CREDIT, up.node, up.port);
+
+            const PortRef& down = topology.out_link[sw][output];
+            if (down.is_host()) {
+                const FabricPacket& packet = pool[handle];
+                stats.record_departure(packet.dst, now + config.host_delay - packet.birth);
+                pool.release(handle);
+                continue;
+            }
+            schedule(now + config.link_delay, EV_ARRIVE, down.node, down.port, handle);
+            if (--s.credits[output] == 0) {
+                const uint64_t* column = s.requests.by_output.row(output);
+                for (int w = 0; w < s.requests.words; ++w) {
+                    for (uint64_t bits = column[w]; bits; bits &= bits - 1) {
+                        s.requests.clear((w << 6) + __builtin_ctzll(bits), output);
+                    }
+                }
+            }
+        }
+    }
+
+    static uint32_t flow_hash(int src, int dst) {
+        uint64_t x = (static_cast<uint64_t>(src) << 32) | static_cast<uint32_t>(dst);
+        x ^= x >> 33;
+        x *= 0xFF51AFD7ED558CCDULL;
+        x ^= x >> 33;
+        return static_cast<uint32_t>(x);
+    }
+
+    const FabricTopology& topology;
+    FabricConfig config;
+    SimStats stats; // ports are destination hosts
+    CounterRng gen;
+    CounterRng arbiter_rng;
+    PacketPool<FabricPacket> pool;
+    std::vector<SwitchState> switches;
+    std::vector<HostState> hosts;
+    std::vector<std::vector<Event>> wheel; // link events by time & wheel_mask
+    uint64_t wheel_mask = 0;
+    size_t wheel_count = 0;
+    std::priority_queue<Event, std::vector<Event>, std::greater<Event>> arrivals; // host generation
+    std::vector<int> active_switches;
+    std::vector<int> active_hosts;
+    double log_idle = 0;
+    uint64_t next_seq = 0;
+    uint64_t switch_steps = 0;
+    uint64_t skipped_cycles = 0;
+    uint64_t event_count = 0;
+};
+
+inline bool parse_fabric_pattern(const std::string& name, FabricPattern& out) {
+    if (name == "uniform") out = FABRIC_UNIFORM;
+    else if (name == "permutation") out = FABRIC_PERMUTATION;
+    else return false;
+    return true;
+}
+
+#endif
@@ -0,0 +1,93 @@
+#include <iostream>
+#include <string>
+#include <chrono>
+#include "fabric_network.h"
+
+// Multi-stage fabric simulator: Lab 4 crossbar switches wired as a 3-stage
+// Clos network or a k-ary fat-tree, with ECMP, link delays and credit-based
+// backpressure.
+// Example: ./fabric_sim --topology fat-tree --k 8 --arbiter islip --load 0.3 --cycles 100000
+//          ./fabric_sim --topology clos --m 8 --n 8 --r 8 --pattern permutation --link-delay 4
+// Arbiters: islip, rr, pim, wavefront, lqf. Patterns: uniform, permutation.
+
+int main(int argc, char* argv[]) {
+    FabricConfig config;
+    std::string topology_name = "fat-tree";
+    int k = 4, m = 4, n = 4, r = 4;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--topology" && i + 1 < argc) {
+            topology_name = argv[++i];
+        } else if (arg == "--k" && i + 1 < argc) {
+            k = std::stoi(argv[++i]);
+        } else if (arg == "--m" && i + 1 < argc) {
+            m = std::stoi(argv[++i]);
+        } else if (arg == "--n" && i + 1 < argc) {
+            n = std::stoi(argv[++i]);
+        } else if (arg == "--r" && i + 1 < argc) {
+            r = std::stoi(argv[++i]);
+        } else if (arg == "--arbiter" && i + 1 < argc) {
+            if (!parse_arbiter(argv[++i], config.arbiter)) {
+                std::cerr << "Unknown arbiter: " << argv[i] << "\n";
+                return 1;
+            }
+        } else if (arg == "--iterations" && i + 1 < argc) {
+            config.iterations = std::stoi(argv[++i]);
+        } else if (arg == "--pattern" && i + 1 < argc) {
+            if (!parse_fabric_pattern(argv[++i], config.pattern)) {
+                std::cerr << "Unknown pattern: " << argv[i] << "\n";
+                return 1;
+            }
+        } else if (arg == "--load" && i + 1 < argc) {
+            config.load = std::stod(argv[++i]);
+        } else if (arg == "--buffer" && i + 1 < argc) {
+            config.port_buffer = std::stoi(argv[++i]);
+        } else if (arg == "--host-queue" && i + 1 < argc) {
+            config.host_queue = std::stoi(argv[++i]);
+        } else if (arg == "--link-delay" && i + 1 < argc) {
+            config.link_delay = std::stoi(argv[++i]);
+        } else if (arg == "--host-delay" && i + 1 < argc) {
+            config.host_delay = std::stoi(argv[++i]);
+        } else if (arg == "--cycles" && i + 1 < argc) {
+            config.cycles = std::stoull(argv[++i]);
+        } else if (arg == "--seed" && i + 1 < argc) {
+            config.seed = std::stoull(argv[++i]);
+        }
+    }
+    if (config.link_delay < 1 || config.host_delay < 1) {
+        std::cerr << "Link delays must be at least one cycle\n";
+        return 1;
+    }
+
+    FabricTopology topology;
+    if (topology_name == "clos") {
+        // Traffic needs a destination other than the source host
+        if (m < 1 || n < 1 || r < 1 || n * r < 2) {
+            std::cerr << "Clos needs --m, --n, --r >= 1 and at least 2 hosts (n * r)\n";
+            return 1;
+        }
+        topology = FabricTopology::clos(m, n, r);
+    } else if (topology_name == "fat-tree" && k >= 2 && k % 2 == 0) {
+        topology = FabricTopology::fat_tree(k);
+    } else {
+        std::cerr << "Unknown topology (clos, or fat-tree with even --k): " << topology_name << "\n";
+        return 1;
+    }
+
+    FabricNetwork network(topology, config);
+    auto start = std::chrono::steady_clock::now();
+    network.run();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << topology.describe() << ": " << topology.num_switches() << " switches, "
+              << topology.num_hosts << " hosts\n";
+    network.get_stats().print(std::cout);
+    uint64_t all_steps = config.cycles * static_cast<uint64_t>(topology.num_switches());
+    std::cout << "Switch-cycles simulated: " << network.get_switch_steps() << " of " << all_steps
+              << " (" << 100.0 * network.get_switch_steps() / all_steps << "%)\n"
+              << "Idle cycles skipped: " << network.get_skipped_cycles() << "\n"
+              << "Events: " << network.get_events() << "\n"
+              << "Wall Time: " << seconds << " s\n";
+    return 0;
+}
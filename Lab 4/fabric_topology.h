@@ -0,0 +1,167 @@
+#ifndef FABRIC_TOPOLOGY_H
+#define FABRIC_TOPOLOGY_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Wiring of a multi-stage fabric built from square crossbar switches. Every
+// switch port has an input side and an output side; a link joins an output
+// port to an input port of another switch or to a host.
+//
+//   clos(m, n, r): r ingress switches (n host inputs, m uplinks), m middle
+//     switches (r x r) and r egress switches (m inputs, n host outputs).
+//   fat_tree(k): k pods of k/2 edge and k/2 aggregation switches plus
+//     (k/2)^2 core switches, all with k ports, serving k^3/4 hosts.
+//     Ports 0 .. k/2-1 face down, k/2 .. k-1 face up.
+//
+// Routing is up/down with ECMP: wherever several uplinks lead to the
+// destination, the flow hash picks one, salted per switch so neighbouring
+// stages do not all make the same choice.
+
+// One end of a link: a switch port, or a host when `node` is negative
+// (host h is node -(h + 1)).
+struct PortRef {
+    int node = -1;
+    int port = 0;
+
+    bool is_host() const { return node < 0; }
+    int host() const { return -node - 1; }
+};
+
+enum TopologyType { TOPO_CLOS, TOPO_FAT_TREE };
+
+class FabricTopology {
+public:
+    static FabricTopology clos(int m, int n, int r) {
+        FabricTopology t;
+        t.type = TOPO_CLOS;
+        t.m = m;
+        t.n = n;
+        t.r = r;
+        t.num_hosts = n * r;
+        int ingress = 0, middle = r, egress = r + m;
+        t.add_switches(r, n > m ? n : m);
+        t.add_switches(m, r);
+        t.add_switches(r, m > n ? m : n);
+        t.host_uplink.resize(t.num_hosts);
+        for (int h = 0; h < t.num_hosts; ++h) {
+            t.attach_host(h, PortRef{ingress + h / n, h % n});
+            t.connect(PortRef{egress + h / n, h % n}, PortRef{-h - 1, 0});
+        }
+        for (int i = 0; i < r; ++i) {
+            for (int j = 0; j < m; ++j) {
+                t.connect(PortRef{ingress + i, j}, PortRef{middle + j, i});
+                t.connect(PortRef{middle + j, i}, PortRef{egress + i, j});
+            }
+        }
+        return t;
+    }
+
+    static FabricTopology fat_tree(int k) {
+        FabricTopology t;
+        t.type = TOPO_FAT_TREE;
+        t.k = k;
+        int half = k / 2;
+        t.num_hosts = k * half * half;
+        t.add_switches(k * half, k);      // edge
+        t.add_switches(k * half, k);      // aggregation
+        t.add_switches(half * half, k);   // core
+        int agg_base = k * half, core_base = 2 * k * half;
+        t.host_uplink.resize(t.num_hosts);
+        for (int h = 0; h < t.num_hosts; ++h) {
+            int edge = h / half;
+            t.attach_host(h, PortRef{edge, h % half});
+            t.connect(PortRef{edge, h % half}, PortRef{-h - 1, 0});
+        }
+        for (int pod = 0; pod < k; ++pod) {
+            for (int e = 0; e < half; ++e) {
+                for (int a = 0; a < half; ++a) {
+                    PortRef edge_up{pod * half + e, half + a};
+                    PortRef agg_down{agg_base + pod * half + a, e};
+                    t.connect(edge_up, agg_down);
+                    t.connect(agg_down, edge_up);
+                }
+            }
+            for (int a = 0; a < half; ++a) {
+                for (int j = 0; j < half; ++j) {
+                    PortRef agg_up{agg_base + pod * half + a, half + j};
+                    PortRef core{core_base + a * half + j, pod};
+                    t.connect(agg_up, core);
+                    t.connect(core, agg_up);
+                }
+            }
+        }
+        return t;
+    }
+
+    // Output port of switch `sw` for a packet to `dst_host`.
+    int route(int sw, int dst_host, uint32_t flow_hash) const {
+        if (type == TOPO_CLOS) {
+            if (sw < r) return static_cast<int>(ecmp(flow_hash, sw) % m);   // ingress
+            if (sw < r + m) return dst_host / n;                            // middle
+            return dst_host % n;                                            // egress
+        }
+        int half = k / 2;
+        int pod_switches = k * half;
+        if (sw < pod_switches) {                                            // edge
+            if (dst_host / half == sw) return dst_host % half;
+            return half + static_cast<int>(ecmp(flow_hash, sw) % half);
+        }
+        if (sw < 2 * pod_switches) {                                        // aggregation
+            int pod = (sw - pod_switches) / half;
+            if (dst_host / (half * half) == pod) return (dst_host / half) % half;
+            return half + static_cast<int>(ecmp(flow_hash, sw) % half);
+        }
+        return dst_host / (half * half);                                    // core
+    }
+
+    int num_switches() const { return static_cast<int>(radix.size()); }
+
+    std::string describe() const {
+        if (type == TOPO_CLOS) {
+            return "Clos(m=" + std::to_string(m) + ", n=" + std::to_string(n) + ", r=" + std::to_string(r) + ")";
+        }
+        return std::to_string(k) + "-ary fat-tree";
+    }
+
+    TopologyType type = TOPO_CLOS;
+    int num_hosts = 0;
+    std::vector<int> radix;                     // ports per switch
+    std::vector<std::vector<PortRef>> out_link; // [switch][port] -> downstream input
+    std::vector<std::vector<PortRef>> in_link;  // [switch][port] -> upstream output
+    std::vector<PortRef> host_uplink;           // switch input port each host sends into
+
+private:
+    void add_switches(int count, int ports) {
+        for (int i = 0; i < count; ++i) {
+            radix.push_back(ports);
+            out_link.emplace_back(ports);
+            in_link.emplace_back(ports);
+        }
+    }
+
+    void attach_host(int host, PortRef input) {
+        host_uplink[host] = input;
+        in_link[input.node][input.port] = PortRef{-host - 1, 0};
+    }
+
+    // Joins output `from` to input `to`; hosts only ever appear as `to`.
+    void connect(PortRef from, PortRef to) {
+        out_link[from.node][from.port] = to;
+        if (!to.is_host()) in_link[to.node][to.port] = from;
+    }
+
+    static uint32_t ecmp(uint32_t flow_hash, int sw) {
+        uint32_t x = flow_hash ^ (static_cast<uint32_t>(sw) * 0x9E3779B9u);
+        x ^= x >> 16;
+        x *= 0x85EBCA6Bu;
+        x ^= x >> 13;
+        return x;
+    }
+
+    int m = 0, n = 0, r = 0; // Clos
+    int k = 0;               // fat-tree
+};
+
+#endif
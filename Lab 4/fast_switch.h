@@ -0,0 +1,164 @@
+#ifndef FAST_SWITCH_H
+#define FAST_SWITCH_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "packet_pool.h"
+#include "rng.h"
+#include "sim_stats.h"
+#include "traffic.h"
+
+// Headless version of the Lab 4 input-queued switch: same cycle structure as
+// iSLIP.cpp (generate, request, grant, accept, transmit) but with no console
+// output, so runs of 10^8 packet-cycles finish in seconds.
+
+enum SchedulerType { SCHED_ISLIP, SCHED_ROUND_ROBIN, SCHED_PRIORITY };
+
+struct SimConfig {
+    int num_ports = 8;
+    int buffer_size = 64;
+    uint64_t cycles = 1000000;
+    SchedulerType scheduler = SCHED_ISLIP;
+    TrafficConfig traffic;
+    const PacketTrace* trace = nullptr; // arrivals for ARRIVAL_TRACE
+    uint64_t seed = 1;
+    uint64_t stream = 0;        // independent RNG stream per run (see rng.h)
+    uint64_t trace_every = 0;   // keep every Nth event in the trace, 0 = off
+};
+
+struct FastPacket {
+    uint32_t id;
+    uint32_t arrival_time;
+    uint16_t output_port;
+    uint8_t priority;
+};
+
+class FastSwitch {
+public:
+    explicit FastSwitch(const SimConfig& config)
+        : config(config), stats(config.num_ports, config.traffic.num_classes), trace(config.trace_every),
+          traffic(config.traffic, config.num_ports, config.seed, config.stream, config.trace),
+          pool(2 * config.num_ports * config.buffer_size),
+          input_queues(config.num_ports, RingQueue(config.buffer_size)),
+          output_queues(config.num_ports, RingQueue(config.buffer_size)),
+          pointer(config.num_ports, 0), grant(config.num_ports, -1) {}
+
+    void run() {
+        for (uint64_t cycle = 0; cycle < config.cycles; ++cycle) {
+            step(cycle);
+        }
+        stats.cycles += config.cycles;
+    }
+
+    const SimStats& get_stats() const { return stats; }
+    const EventTrace& get_trace() const { return trace; }
+
+private:
+    void step(uint64_t cycle) {
+        generate_packets(cycle);
+        grant_requests();
+        accept_and_transmit(cycle);
+    }
+
+    void enqueue(int input, int output, int traffic_class, uint64_t cycle) {
+        stats.generated++;
+        if (input_queues[input].full()) {
+            stats.record_drop(input);
+            trace.record(cycle, next_id++, input, EVENT_DROP);
+            return;
+        }
+        PacketHandle handle = pool.allocate();
+        // Class 0 is the highest priority; the lab code uses larger = higher.
+        uint8_t priority = static_cast<uint8_t>(config.traffic.num_classes - traffic_class);
+        pool[handle] = FastPacket{next_id, static_cast<uint32_t>(cycle),
+                                  static_cast<uint16_t>(output), priority};
+        input_queues[input].push(handle);
+        trace.record(cycle, next_id++, input, EVENT_ARRIVAL);
+    }
+
+    void generate_packets(uint64_t cycle) {
+        traffic.generate(cycle, [&](int input, int output, int traffic_class) {
+            enqueue(input, output, traffic_class, cycle);
+        });
+    }
+
+    // Each input requests the output of its head-of-line packet; each output
+    // grants one requester. With a single request per input every grant is
+    // accepted, so grant and accept collapse into one pass.
+    void grant_requests() {
+        int n = config.num_ports;
+        std::fill(grant.begin(), grant.end(), -1);
+        for (int input = 0; input < n; ++input) {
+            if (input_queues[input].empty()) continue;
+            const FastPacket& head = pool[input_queues[input].front()];
+            int output = head.output_port;
+            int current = grant[output];
+            if (current == -1 || better(output, input, head, current)) {
+                grant[output] = input;
+            }
+        }
+    }
+
+    bool better(int output, int input, const FastPacket& head, int current) const {
+        int n = config.num_ports;
+        if (config.scheduler == SCHED_PRIORITY) {
+            uint8_t current_priority = pool[input_queues[current].front()].priority;
+            if (head.priority != current_priority) return head.priority > current_priority;
+            return false; // ties go to the lower input index
+        }
+        // Round-robin distance from the output's pointer.
+        int d_input = input - pointer[output];
+        int d_current = current - pointer[output];
+        if (d_input < 0) d_input += n;
+        if (d_current < 0) d_current += n;
+        return d_input < d_current;
+    }
+
+    void accept_and_transmit(uint64_t cycle) {
+        int n = config.num_ports;
+        for (int output = 0; output < n; ++output) {
+            int input = grant[output];
+            if (input != -1) {
+                PacketHandle handle = input_queues[input].pop();
+                output_queues[output].push(handle); // at most one arrival per output per cycle
+                trace.record(cycle, pool[handle].id, output, EVENT_GRANT);
+                if (config.scheduler == SCHED_ISLIP) {
+                    pointer[output] = input + 1 == n ? 0 : input + 1; // one past the accepted input
+                }
+            }
+            if (config.scheduler == SCHED_ROUND_ROBIN) {
+                pointer[output] = pointer[output] + 1 == n ? 0 : pointer[output] + 1; // rotates every cycle
+            }
+            if (!output_queues[output].empty()) {
+                PacketHandle handle = output_queues[output].pop();
+                const FastPacket& packet = pool[handle];
+                stats.record_departure(output, cycle - packet.arrival_time,
+                                       config.traffic.num_classes - packet.priority);
+                trace.record(cycle, packet.id, output, EVENT_DEPARTURE);
+                pool.release(handle);
+            }
+        }
+    }
+
+    SimConfig config;
+    SimStats stats;
+    EventTrace trace;
+    TrafficGenerator traffic;
+    uint32_t next_id = 0;
+    PacketPool<FastPacket> pool;
+    std::vector<RingQueue> input_queues;
+    std::vector<RingQueue> output_queues;
+    std::vector<int> pointer; // per-output round-robin pointer
+    std::vector<int> grant;   // granted input per output, -1 if none
+};
+
+inline bool parse_scheduler(const std::string& name, SchedulerType& out) {
+    if (name == "islip") out = SCHED_ISLIP;
+    else if (name == "rr" || name == "round-robin") out = SCHED_ROUND_ROBIN;
+    else if (name == "priority") out = SCHED_PRIORITY;
+    else return false;
+    return true;
+}
+
+#endif
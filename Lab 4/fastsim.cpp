@@ -0,0 +1,113 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include "fast_switch.h"
+
+// Headless driver for the Lab 4 switch schedulers.
+// Example: ./fastsim --scheduler islip --pattern uniform --ports 8 --cycles 12500000 --load 0.9
+// Add --trace-every 1000 --trace-file trace.txt to keep a sampled event trace,
+// and --latency for per-port and per-class delay percentiles. --check-load
+// compares the offered load (packets generated per port-cycle) with --load.
+// Patterns: uniform, non-uniform/hotspot, diagonal, bursty, bursty-hotspot,
+// bursty-diagonal (see traffic.h). --pcap file.pcap replays a capture instead.
+
+int main(int argc, char* argv[]) {
+    SimConfig config;
+    std::string trace_file;
+    std::string pcap_file;
+    double cycle_us = 1.0;
+    bool per_port_latency = false;
+    bool check_load = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--scheduler" && i + 1 < argc) {
+            if (!parse_scheduler(argv[++i], config.scheduler)) {
+                std::cerr << "Unknown scheduler: " << argv[i] << "\n";
+                return 1;
+            }
+        } else if (arg == "--pattern" && i + 1 < argc) {
+            if (!parse_traffic(argv[++i], config.traffic)) {
+                std::cerr << "Unknown traffic pattern: " << argv[i] << "\n";
+                return 1;
+            }
+        } else if (arg == "--burst-length" && i + 1 < argc) {
+            config.traffic.mean_burst = std::stod(argv[++i]);
+        } else if (arg == "--hotspot-fraction" && i + 1 < argc) {
+            config.traffic.hotspot_fraction = std::stod(argv[++i]);
+        } else if (arg == "--pcap" && i + 1 < argc) {
+            pcap_file = argv[++i];
+        } else if (arg == "--cycle-us" && i + 1 < argc) {
+            cycle_us = std::stod(argv[++i]);
+        } else if (arg == "--ports" && i + 1 < argc) {
+            config.num_ports = std::stoi(argv[++i]);
+        } else if (arg == "--buffer" && i + 1 < argc) {
+            config.buffer_size = std::stoi(argv[++i]);
+        } else if (arg == "--cycles" && i + 1 < argc) {
+            config.cycles = std::stoull(argv[++i]);
+        } else if (arg == "--load" && i + 1 < argc) {
+            config.traffic.load = std::stod(argv[++i]);
+        } else if (arg == "--seed" && i + 1 < argc) {
+            config.seed = std::stoull(argv[++i]);
+        } else if (arg == "--trace-every" && i + 1 < argc) {
+            config.trace_every = std::stoull(argv[++i]);
+        } else if (arg == "--trace-file" && i + 1 < argc) {
+            trace_file = argv[++i];
+        } else if (arg == "--latency") {
+            per_port_latency = true;
+        } else if (arg == "--check-load") {
+            check_load = true;
+        }
+    }
+
+    PacketTrace pcap_trace;
+    if (!pcap_file.empty()) {
+        if (!pcap_trace.load_pcap(pcap_file, cycle_us)) {
+            std::cerr << "Could not read packet trace: " << pcap_file << "\n";
+            return 1;
+        }
+        config.traffic.arrivals = ARRIVAL_TRACE;
+        config.trace = &pcap_trace;
+        if (config.cycles == SimConfig().cycles) {
+            config.cycles = pcap_trace.get_records().back().cycle + 1; // replay the whole trace
+        }
+    }
+
+    FastSwitch fabric(config);
+    auto start = std::chrono::steady_clock::now();
+    fabric.run();
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+
+    fabric.get_stats().print(std::cout);
+    if (per_port_latency) {
+        std::cout << "\nQueueing delay (cycles)\n";
+        fabric.get_stats().print_latency(std::cout);
+    }
+    double packet_cycles = static_cast<double>(config.cycles) * config.num_ports;
+    std::cout << "Wall Time: " << seconds << " s ("
+              << packet_cycles / seconds / 1e6 << " M port-cycles/s)\n";
+
+    if (!trace_file.empty()) {
+        std::ofstream out(trace_file);
+        fabric.get_trace().dump(out);
+    }
+
+    if (check_load && config.traffic.arrivals != ARRIVAL_TRACE) {
+        // Allow five standard deviations of the sample mean; consecutive
+        // cycles of a burst are correlated, which widens it by about the
+        // burst length.
+        double load = config.traffic.load;
+        double offered = fabric.get_stats().generated / packet_cycles;
+        double burst = config.traffic.arrivals == ARRIVAL_ONOFF ? std::max(1.0, config.traffic.mean_burst) : 1.0;
+        double tolerance = 5 * std::sqrt(load * (1 - load) * 2 * burst / packet_cycles) + 1e-3;
+        bool ok = std::fabs(offered - load) <= tolerance;
+        std::cout << "Offered load: " << offered << " (--load " << load << ", tolerance " << tolerance
+                  << "): " << (ok ? "ok" : "WRONG") << "\n";
+        if (!ok) return 1;
+    }
+    return 0;
+}
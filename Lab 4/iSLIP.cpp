@@ -1,6 +1,6 @@
 #include <iostream>
 #include <vector>
-#include <queue>
+#include <deque>
 #include <iomanip>
 #include <random>
 #include <algorithm> // For std::remove
@@ -23,13 +23,14 @@ struct Packet {
 };
 
 struct SwitchFabric {
-    vector<queue<Packet>> input_queues;
-    vector<queue<Packet>> output_queues;
+    vector<deque<Packet>> input_queues;
+    vector<deque<Packet>> output_queues;
     vector<vector<int>> requests;
     vector<int> grants; // Track granted input port for each output port
     vector<int> last_grant; // Track last granted input port for each output port
     vector<vector<int>> priorities; // Track the order of input ports for each output port
-    int packet_id_counter;
+    int packet_id_counter = 0;
+    mt19937 gen{random_device{}()}; // Seeded once, not per cycle
 
     // Stats tracking variables
     int total_turnaround_time = 0;
@@ -53,8 +54,6 @@ struct SwitchFabric {
     }
 
     void generate_packets(int cycle, TrafficPattern pattern) {
-        random_device rd;
-        mt19937 gen(rd());
         uniform_int_distribution<> output_dist(0, NUM_PORTS - 1);
         uniform_int_distribution<> burst_dist(1, 3); // For bursty traffic
 
@@ -74,7 +73,7 @@ struct SwitchFabric {
                         if (input_queues[port].size() < BUFFER_SIZE) {
                             output_port = output_dist(gen);
                             Packet packet(packet_id_counter++, port, output_port, cycle);
-                            input_queues[port].push(packet);
+                            input_queues[port].push_back(packet);
                             total_packets_generated++; // Track total packets generated
                             cout << "Generated Packet " << packet.id << " at input port " << port 
                                  << " destined for output port " << output_port << endl;
@@ -84,7 +83,7 @@ struct SwitchFabric {
                 }
 
                 Packet packet(packet_id_counter++, port, output_port, cycle);
-                input_queues[port].push(packet);
+                input_queues[port].push_back(packet);
                 total_packets_generated++; // Track total packets generated
                 cout << "Generated Packet " << packet.id << " at input port " << port 
                      << " destined for output port " << output_port << endl;
@@ -101,10 +100,8 @@ struct SwitchFabric {
         cout << "Input Queues:" << endl;
         for (int i = 0; i < NUM_PORTS; ++i) {
             cout << "Input port " << i << ": [";
-            queue<Packet> temp = input_queues[i];
-            while (!temp.empty()) {
-                cout << temp.front().id << " ";
-                temp.pop();
+            for (const Packet& packet : input_queues[i]) {
+                cout << packet.id << " ";
             }
             cout << "] (Size: " << input_queues[i].size() << ")" << endl;
         }
@@ -114,10 +111,8 @@ struct SwitchFabric {
         cout << "Output Queues:" << endl;
         for (int i = 0; i < NUM_PORTS; ++i) {
             cout << "Output port " << i << ": [";
-            queue<Packet> temp = output_queues[i];
-            while (!temp.empty()) {
-                cout << temp.front().id << " ";
-                temp.pop();
+            for (const Packet& packet : output_queues[i]) {
+                cout << packet.id << " ";
             }
             cout << "] (Size: " << output_queues[i].size() << ")" << endl;
         }
@@ -177,8 +172,8 @@ struct SwitchFabric {
                 int input_port = grants[i];
                 if (!input_queues[input_port].empty()) {
                     Packet packet = input_queues[input_port].front();
-                    input_queues[input_port].pop(); // Accept the packet
-                    output_queues[i].push(packet); // Move packet to output queue
+                    input_queues[input_port].pop_front(); // Accept the packet
+                    output_queues[i].push_back(packet); // Move packet to output queue
                     cout << "Accepted Packet " << packet.id << " from Input Port " << input_port 
                          << " to Output Port " << i << endl;
                 } else {
@@ -212,7 +207,7 @@ struct SwitchFabric {
         for (int i = 0; i < NUM_PORTS; ++i) {
             if (!output_queues[i].empty()) {
                 Packet packet = output_queues[i].front();
-                output_queues[i].pop(); // Send the packet
+                output_queues[i].pop_front(); // Send the packet
 
                 // Update statistics
                 total_packets_transmitted++;
@@ -0,0 +1,90 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+#include <vector>
+
+// HDR-style log-bucketed histogram of integer delays (in cycles). Values
+// below 2^SUB_BITS are counted exactly; above that each power-of-two range is
+// split into 2^SUB_BITS linear buckets, so the relative error of any reported
+// percentile is under 2^-SUB_BITS (about 3% with SUB_BITS = 5). Recording is
+// a bit scan, a shift and an increment, cheap enough for the headless path.
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BITS = 5;
+    static constexpr int SUB_BUCKETS = 1 << SUB_BITS;
+    static constexpr int NUM_BUCKETS = (64 - SUB_BITS + 1) * SUB_BUCKETS;
+
+    LatencyHistogram() : counts(NUM_BUCKETS, 0) {}
+
+    void record(uint64_t value) {
+        counts[bucket_of(value)]++;
+        total++;
+        if (value > max_value) max_value = value;
+    }
+
+    void merge(const LatencyHistogram& other) {
+        for (int i = 0; i < NUM_BUCKETS; ++i) counts[i] += other.counts[i];
+        total += other.total;
+        if (other.max_value > max_value) max_value = other.max_value;
+    }
+
+    // Smallest recorded bucket value v such that at least p of samples are <= v.
+    uint64_t percentile(double p) const {
+        if (total == 0) return 0;
+        uint64_t rank = static_cast<uint64_t>(p * total + 0.5);
+        if (rank < 1) rank = 1;
+        if (rank > total) rank = total;
+        uint64_t seen = 0;
+        for (int i = 0; i < NUM_BUCKETS; ++i) {
+            seen += counts[i];
+            if (seen >= rank) {
+                uint64_t upper = bucket_upper(i);
+                return upper < max_value ? upper : max_value;
+            }
+        }
+        return max_value;
+    }
+
+    uint64_t count() const { return total; }
+    uint64_t max() const { return max_value; }
+
+    // One line: count, p50, p99, p99.9, max.
+    void print(std::ostream& out, const char* label) const {
+        out << std::left << std::setw(14) << label << std::right
+            << std::setw(12) << total << std::setw(8) << percentile(0.50)
+            << std::setw(8) << percentile(0.99) << std::setw(8) << percentile(0.999)
+            << std::setw(8) << max_value << "\n";
+    }
+
+    static void print_header(std::ostream& out) {
+        out << std::left << std::setw(14) << "" << std::right << std::setw(12) << "count"
+            << std::setw(8) << "p50" << std::setw(8) << "p99" << std::setw(8) << "p99.9"
+            << std::setw(8) << "max" << "\n";
+    }
+
+private:
+    static int bucket_of(uint64_t value) {
+        if (value < SUB_BUCKETS) return static_cast<int>(value);
+        int magnitude = 63 - __builtin_clzll(value); // >= SUB_BITS
+        int shift = magnitude - SUB_BITS;
+        int sub = static_cast<int>(value >> shift) - SUB_BUCKETS; // 0 .. SUB_BUCKETS - 1
+        return (shift + 1) * SUB_BUCKETS + sub;
+    }
+
+    // Largest value that maps to bucket i.
+    static uint64_t bucket_upper(int i) {
+        if (i < SUB_BUCKETS) return static_cast<uint64_t>(i);
+        int shift = i / SUB_BUCKETS - 1;
+        uint64_t sub = static_cast<uint64_t>(i % SUB_BUCKETS) + SUB_BUCKETS;
+        return ((sub + 1) << shift) - 1;
+    }
+
+    std::vector<uint64_t> counts;
+    uint64_t total = 0;
+    uint64_t max_value = 0;
+};
+
+#endif
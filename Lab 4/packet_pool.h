@@ -0,0 +1,93 @@
+#ifndef PACKET_POOL_H
+#define PACKET_POOL_H
+
+#include <cstdint>
+#include <vector>
+
+// Packets live in one contiguous pool and queues carry 32-bit handles, so
+// moving a packet between queues copies 4 bytes instead of the whole struct.
+// All storage is allocated up front; nothing is allocated in the hot loop.
+
+using PacketHandle = uint32_t;
+constexpr PacketHandle NULL_HANDLE = UINT32_MAX;
+
+template <typename T>
+class PacketPool {
+public:
+    explicit PacketPool(uint32_t capacity) : slots(capacity), free_list(capacity) {
+        // Hand out low indices first so a lightly loaded run stays in cache.
+        for (uint32_t i = 0; i < capacity; ++i) {
+            free_list[i] = capacity - 1 - i;
+        }
+    }
+
+    // Returns NULL_HANDLE when the pool is exhausted.
+    PacketHandle allocate() {
+        if (free_list.empty()) return NULL_HANDLE;
+        PacketHandle handle = free_list.back();
+        free_list.pop_back();
+        return handle;
+    }
+
+    void release(PacketHandle handle) { free_list.push_back(handle); }
+
+    T& operator[](PacketHandle handle) { return slots[handle]; }
+    const T& operator[](PacketHandle handle) const { return slots[handle]; }
+
+    uint32_t capacity() const { return static_cast<uint32_t>(slots.size()); }
+    uint32_t in_use() const { return capacity() - static_cast<uint32_t>(free_list.size()); }
+
+private:
+    std::vector<T> slots;
+    std::vector<PacketHandle> free_list; // reserved at construction, never grows
+};
+
+// Fixed-capacity FIFO of handles. Capacity is rounded up to a power of two
+// so wrap-around is a mask; the usable limit is enforced by push() returning
+// false, replacing the hand-written BUFFER_SIZE / MAX_QUEUE_SIZE checks.
+class RingQueue {
+public:
+    explicit RingQueue(uint32_t limit = 0) { reset(limit); }
+
+    void reset(uint32_t new_limit) {
+        uint32_t capacity = 1;
+        while (capacity < new_limit) capacity <<= 1;
+        items.assign(capacity, NULL_HANDLE);
+        mask = capacity - 1;
+        limit = new_limit;
+        head = tail = 0;
+    }
+
+    bool push(PacketHandle handle) {
+        if (tail - head >= limit) return false;
+        items[tail & mask] = handle;
+        tail++;
+        return true;
+    }
+
+    PacketHandle front() const { return items[head & mask]; }
+    PacketHandle back() const { return items[(tail - 1) & mask]; }
+
+    PacketHandle pop() {
+        PacketHandle handle = items[head & mask];
+        head++;
+        return handle;
+    }
+
+    // i-th element from the front, for display and scans.
+    PacketHandle at(uint32_t i) const { return items[(head + i) & mask]; }
+
+    bool empty() const { return head == tail; }
+    bool full() const { return tail - head >= limit; }
+    uint32_t size() const { return tail - head; }
+    uint32_t max_size() const { return limit; }
+
+private:
+    std::vector<PacketHandle> items;
+    uint32_t mask = 0;
+    uint32_t limit = 0;
+    uint32_t head = 0; // free-running counters; unsigned wrap keeps size() correct
+    uint32_t tail = 0;
+};
+
+#endif
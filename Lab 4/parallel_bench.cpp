@@ -0,0 +1,73 @@
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <iomanip>
+#include <thread>
+#include "parallel_switch.h"
+#include "voq_switch.h"
+
+// Thread scaling of the partitioned iSLIP simulator. Every thread count must
+// reproduce the single-thread counters exactly; the sequential VoqSwitch is
+// timed alongside as the baseline.
+// Usage: ./parallel_bench [ports] [cycles] [load] [pattern] [max threads]
+
+int main(int argc, char* argv[]) {
+    int ports = argc > 1 ? std::stoi(argv[1]) : 1024;
+    uint64_t cycles = argc > 2 ? std::stoull(argv[2]) : 2000;
+    double load = argc > 3 ? std::stod(argv[3]) : 0.9;
+    std::string pattern = argc > 4 ? argv[4] : "uniform";
+    int max_threads = argc > 5 ? std::stoi(argv[5]) : static_cast<int>(std::thread::hardware_concurrency());
+    if (max_threads < 1) max_threads = 1;
+
+    TrafficConfig traffic;
+    if (!parse_traffic(pattern, traffic)) {
+        std::cerr << "Unknown pattern: " << pattern << "\n";
+        return 1;
+    }
+    traffic.load = load;
+
+    std::cout << ports << " ports, " << cycles << " cycles, " << pattern << " traffic, load " << load << "\n";
+
+    VoqConfig sequential;
+    sequential.num_ports = ports;
+    sequential.cycles = cycles;
+    sequential.traffic = traffic;
+    VoqSwitch baseline(sequential);
+    auto start = std::chrono::steady_clock::now();
+    baseline.run();
+    double baseline_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "VoqSwitch (1 thread): " << std::fixed << std::setprecision(3) << baseline_seconds
+              << " s, throughput " << std::setprecision(4) << baseline.get_stats().throughput() << "\n\n";
+
+    std::cout << "threads   seconds   speedup   throughput   p99 delay   identical\n";
+    uint64_t reference_transmitted = 0, reference_delay = 0, reference_dropped = 0;
+    double single_seconds = 0;
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        ParallelConfig config;
+        config.num_ports = ports;
+        config.cycles = cycles;
+        config.threads = threads;
+        config.traffic = traffic;
+        ParallelVoqSwitch fabric(config);
+        start = std::chrono::steady_clock::now();
+        fabric.run();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        const SimStats& stats = fabric.get_stats();
+        if (threads == 1) {
+            single_seconds = seconds;
+            reference_transmitted = stats.transmitted;
+            reference_delay = stats.total_delay;
+            reference_dropped = stats.dropped;
+        }
+        bool identical = stats.transmitted == reference_transmitted && stats.total_delay == reference_delay &&
+                         stats.dropped == reference_dropped;
+        std::cout << std::setw(7) << threads << std::setprecision(3) << std::setw(10) << seconds
+                  << std::setprecision(2) << std::setw(10) << single_seconds / seconds
+                  << std::setprecision(4) << std::setw(13) << stats.throughput()
+                  << std::setw(12) << stats.delay_histogram().percentile(0.99)
+                  << std::setw(12) << (identical ? "yes" : "NO") << "\n";
+        if (threads < max_threads && threads * 2 > max_threads) threads = max_threads / 2;
+    }
+    return 0;
+}
@@ -0,0 +1,250 @@
+#ifndef PARALLEL_SWITCH_H
+#define PARALLEL_SWITCH_H
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "arbiters.h"
+#include "packet_pool.h"
+#include "sim_stats.h"
+#include "traffic.h"
+#include "voq_switch.h"
+
+// Multi-threaded VOQ switch with an iSLIP fabric for 256- to 1024-port runs.
+//
+// Ports are split into groups of GROUP_PORTS (one 64-bit word of every
+// request bitset), and each worker thread owns a contiguous range of groups.
+// A cycle runs in barrier-separated phases:
+//   1. outputs record last cycle's departures; inputs take arrivals
+//   2. grant: each free output picks a requesting free input
+//   3. accept: each free input picks a granting output and moves the packet
+// with phases 2-3 repeated for every iSLIP iteration. Every shared word is
+// written by exactly one owner per phase, so there are no locks or atomics
+// outside the barrier.
+//
+// Each group draws arrivals from its own RNG stream and nothing depends on
+// the thread count, so a given seed gives identical results with 1 or 64
+// threads. With one group (up to 64 ports) the run matches VoqSwitch with
+// the iSLIP arbiter packet for packet.
+
+constexpr int GROUP_PORTS = 64;
+
+// Spinning barrier: waiters spin on a generation counter and
+// yield after a while, so it also behaves on an oversubscribed machine.
+class SpinBarrier {
+public:
+    explicit SpinBarrier(int parties) : parties(parties) {}
+
+    void wait() {
+        unsigned gen = generation.load(std::memory_order_acquire);
+        if (arrived.fetch_add(1, std::memory_order_acq_rel) + 1 == parties) {
+            arrived.store(0, std::memory_order_relaxed);
+            generation.fetch_add(1, std::memory_order_release);
+            return;
+        }
+        for (int spins = 0; generation.load(std::memory_order_acquire) == gen; ++spins) {
+            if (spins > 256) std::this_thread::yield();
+        }
+    }
+
+private:
+    int parties;
+    std::atomic<int> arrived{0};
+    std::atomic<unsigned> generation{0};
+};
+
+struct ParallelConfig {
+    int num_ports = 256;
+    int voq_limit = 64;
+    int input_buffer = 256;
+    int iterations = 1;         // iSLIP iterations per cycle
+    int threads = 1;
+    uint64_t cycles = 100000;
+    uint64_t seed = 1;
+    uint64_t stream = 0;
+    TrafficConfig traffic;      // trace replay is not supported here
+};
+
+class ParallelVoqSwitch {
+public:
+    explicit ParallelVoqSwitch(const ParallelConfig& config)
+        : config(config), n(config.num_ports), words((config.num_ports + 63) / 64),
+          stats(config.num_ports, config.traffic.num_classes),
+          voqs(static_cast<size_t>(config.num_ports) * config.num_ports, RingQueue(config.voq_limit)),
+          input_occupancy(config.num_ports, 0), free_inputs(words, 0),
+          output_matched(config.num_ports, 0), granted_to(config.num_ports, -1),
+          grant_pointer(config.num_ports, 0), accept_pointer(config.num_ports, 0),
+          departing(config.num_ports) {
+        requests.reset(n);
+        grants.reset(n);
+        int num_groups = (n + GROUP_PORTS - 1) / GROUP_PORTS;
+        for (int g = 0; g < num_groups; ++g) {
+            int begin = g * GROUP_PORTS;
+            int end = begin + GROUP_PORTS < n ? begin + GROUP_PORTS : n;
+            TrafficConfig traffic = config.traffic;
+            if (traffic.arrivals == ARRIVAL_TRACE) traffic.arrivals = ARRIVAL_BERNOULLI;
+            groups.emplace_back(traffic, n, config.seed, config.stream ^ (static_cast<uint64_t>(g) << 48),
+                                begin, end, config.input_buffer, config.traffic.num_classes);
+        }
+    }
+
+    void run() {
+        int num_threads = config.threads < 1 ? 1 : config.threads;
+        if (num_threads > static_cast<int>(groups.size())) num_threads = static_cast<int>(groups.size());
+        SpinBarrier barrier(num_threads);
+        std::vector<std::thread> workers;
+        for (int t = 1; t < num_threads; ++t) {
+            workers.emplace_back([this, t, num_threads, &barrier] { worker(t, num_threads, barrier); });
+        }
+        worker(0, num_threads, barrier);
+        for (std::thread& w : workers) w.join();
+
+        for (Group& g : groups) {
+            stats.merge(g.stats);
+            g.stats = SimStats(0, config.traffic.num_classes);
+        }
+        stats.cycles += config.cycles;
+    }
+
+    const SimStats& get_stats() const { return stats; }
+
+private:
+    struct Departure {
+        uint32_t arrival_time;
+        uint32_t traffic_class;
+        bool valid = false;
+    };
+
+    // Inputs and outputs [begin, end) with their own arrivals, packet pool
+    // and scalar counters; per-port counters live in the shared SimStats and
+    // are only touched by the owning group.
+    struct Group {
+        Group(const TrafficConfig& traffic_config, int ports, uint64_t seed, uint64_t stream,
+              int begin, int end, int input_buffer, int num_classes)
+            : begin(begin), end(end),
+              traffic(traffic_config, ports, seed, stream, nullptr, begin, end),
+              pool(static_cast<uint32_t>(end - begin) * input_buffer), stats(0, num_classes) {}
+
+        int begin, end;
+        TrafficGenerator traffic;
+        PacketPool<VoqPacket> pool;
+        SimStats stats;
+    };
+
+    void worker(int thread, int num_threads, SpinBarrier& barrier) {
+        size_t first = groups.size() * thread / num_threads;
+        size_t last = groups.size() * (thread + 1) / num_threads;
+        std::vector<uint64_t> scratch(words);
+
+        for (uint64_t cycle = 0; cycle < config.cycles; ++cycle) {
+            for (size_t g = first; g < last; ++g) {
+                if (cycle > 0) record_departures(groups[g], cycle - 1);
+                arrivals(groups[g], cycle);
+            }
+            barrier.wait();
+            for (int iteration = 0; iteration < config.iterations; ++iteration) {
+                for (size_t g = first; g < last; ++g) grant(groups[g], scratch);
+                barrier.wait();
+                for (size_t g = first; g < last; ++g) accept(groups[g], iteration);
+                barrier.wait();
+            }
+        }
+        for (size_t g = first; g < last; ++g) record_departures(groups[g], config.cycles - 1);
+    }
+
+    void record_departures(Group& group, uint64_t cycle) {
+        for (int output = group.begin; output < group.end; ++output) {
+            Departure& d = departing[output];
+            if (!d.valid) continue;
+            uint64_t delay = cycle - d.arrival_time;
+            stats.transmitted_per_port[output]++;
+            stats.delay_by_port[output].record(delay);
+            SimStats& local = group.stats;
+            local.transmitted++;
+            local.total_delay += delay;
+            if (delay > local.max_delay) local.max_delay = delay;
+            if (d.traffic_class < local.delay_by_class.size()) local.delay_by_class[d.traffic_class].record(delay);
+            d.valid = false;
+        }
+    }
+
+    void arrivals(Group& group, uint64_t cycle) {
+        group.traffic.generate(cycle, [&](int input, int output, int traffic_class) {
+            group.stats.generated++;
+            size_t index = static_cast<size_t>(input) * n + output;
+            if (input_occupancy[input] >= config.input_buffer || voqs[index].full()) {
+                group.stats.dropped++;
+                stats.dropped_per_port[input]++;
+                return;
+            }
+            PacketHandle handle = group.pool.allocate();
+            group.pool[handle] = VoqPacket{static_cast<uint32_t>(cycle), static_cast<uint32_t>(traffic_class)};
+            voqs[index].push(handle);
+            input_occupancy[input]++;
+            if (requests.length[index]++ == 0) requests.set(input, output);
+        });
+
+        // A group is exactly one word of the input bitsets.
+        int w = group.begin >> 6;
+        int count = group.end - group.begin;
+        free_inputs[w] = count == 64 ? ~uint64_t(0) : (uint64_t(1) << count) - 1;
+        for (int output = group.begin; output < group.end; ++output) output_matched[output] = 0;
+    }
+
+    void grant(Group& group, std::vector<uint64_t>& scratch) {
+        for (int output = group.begin; output < group.end; ++output) {
+            if (granted_to[output] >= 0) grants.clear(granted_to[output], output);
+            granted_to[output] = -1;
+            if (output_matched[output]) continue;
+            bits_and(requests.by_output.row(output), free_inputs.data(), scratch.data(), words);
+            if (!bits_any(scratch.data(), words)) continue;
+            int input = bits_find_wrapped(scratch.data(), words, grant_pointer[output]);
+            granted_to[output] = input;
+            grants.set(input, output);
+        }
+    }
+
+    void accept(Group& group, int iteration) {
+        int w = group.begin >> 6;
+        for (uint64_t bits = free_inputs[w]; bits; bits &= bits - 1) {
+            int input = (w << 6) + __builtin_ctzll(bits);
+            int output = bits_find_wrapped(grants.row(input), words, accept_pointer[input]);
+            if (output < 0) continue;
+
+            free_inputs[w] &= ~(uint64_t(1) << (input & 63));
+            output_matched[output] = 1;
+            if (iteration == 0) {
+                grant_pointer[output] = input + 1 == n ? 0 : input + 1;
+                accept_pointer[input] = output + 1 == n ? 0 : output + 1;
+            }
+
+            // Cross the fabric now: only this input's row and this input's
+            // word of the output's column change.
+            size_t index = static_cast<size_t>(input) * n + output;
+            PacketHandle handle = voqs[index].pop();
+            if (--requests.length[index] == 0) requests.clear(input, output);
+            input_occupancy[input]--;
+            const VoqPacket& packet = group.pool[handle];
+            departing[output] = Departure{packet.arrival_time, packet.traffic_class, true};
+            group.pool.release(handle);
+        }
+    }
+
+    ParallelConfig config;
+    int n;
+    int words;
+    SimStats stats;
+    std::vector<Group> groups;
+    std::vector<RingQueue> voqs;
+    std::vector<int> input_occupancy;
+    RequestMatrix requests;
+    std::vector<uint64_t> free_inputs;   // one word per group
+    std::vector<uint8_t> output_matched; // written by the accepting input's group
+    std::vector<int> granted_to;
+    BitMatrix grants;                    // row i: outputs granting input i; word w written by group w
+    std::vector<int> grant_pointer, accept_pointer;
+    std::vector<Departure> departing;    // crossed the fabric, leaves next phase 1
+};
+
+#endif
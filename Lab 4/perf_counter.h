@@ -0,0 +1,73 @@
+#ifndef PERF_COUNTER_H
+#define PERF_COUNTER_H
+
+#include <cstdint>
+
+// Minimal hardware counter reader for the benchmarks. Uses perf_event_open on
+// Linux; elsewhere, or when the kernel refuses (containers, perf_event_paranoid),
+// available() is false and stop() returns 0.
+
+#ifdef __linux__
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+class PerfCounter {
+public:
+    enum Event { CACHE_MISSES, CACHE_REFERENCES, INSTRUCTIONS };
+
+    explicit PerfCounter(Event event) {
+#ifdef __linux__
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = event == CACHE_MISSES ? PERF_COUNT_HW_CACHE_MISSES
+                    : event == CACHE_REFERENCES ? PERF_COUNT_HW_CACHE_REFERENCES
+                    : PERF_COUNT_HW_INSTRUCTIONS;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+#else
+        (void)event;
+#endif
+    }
+
+    ~PerfCounter() {
+#ifdef __linux__
+        if (fd >= 0) close(fd);
+#endif
+    }
+
+    PerfCounter(const PerfCounter&) = delete;
+    PerfCounter& operator=(const PerfCounter&) = delete;
+
+    bool available() const { return fd >= 0; }
+
+    void start() {
+#ifdef __linux__
+        if (fd < 0) return;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+
+    uint64_t stop() {
+        uint64_t value = 0;
+#ifdef __linux__
+        if (fd < 0) return 0;
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        if (::read(fd, &value, sizeof(value)) != static_cast<ssize_t>(sizeof(value))) value = 0;
+#endif
+        return value;
+    }
+
+private:
+    int fd = -1;
+};
+
+#endif
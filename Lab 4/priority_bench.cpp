@@ -0,0 +1,194 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <iomanip>
+#include <algorithm>
+#include <string>
+#include "strict_priority.h"
+#include "rng.h"
+#include "latency_histogram.h"
+
+// Strict-priority benchmark.
+//  1. Per-priority latency percentiles for each starvation guard.
+//  2. Scaling across port counts: how an output finds the input with the
+//     highest-priority head, by the linear scan of priority.cpp or by
+//     bitmaps, on the same queues and arrivals.
+// Usage: ./priority_bench [cycles] [load]
+
+constexpr int LEVELS = 8;
+
+// Level 0 gets half the traffic, level 1 a quarter, and so on.
+int pick_level(CounterRng& gen) {
+    uint64_t bits = gen() | (uint64_t(1) << (LEVELS - 1));
+    return __builtin_ctzll(bits);
+}
+
+// Output-queued switch: every cycle each input sends a packet with
+// probability `load` to a random output, and each output sends one packet.
+void latency_by_guard(StarvationGuard guard, const std::string& name, int ports, int cycles, double load) {
+    PriorityConfig config;
+    config.levels = LEVELS;
+    config.queue_limit = 256;
+    config.guard = guard;
+    config.aging_threshold = 200;
+    config.guard_interval = 16;
+
+    PacketPool<PriorityPacket> pool(ports * LEVELS * config.queue_limit);
+    std::vector<StrictPriorityPort> outputs(ports, StrictPriorityPort(config, pool));
+    std::vector<LatencyHistogram> delays(LEVELS);
+    std::vector<uint64_t> drops(LEVELS, 0);
+    CounterRng gen(7, 0); // same arrivals for every guard
+    uint32_t next_id = 0;
+
+    for (int cycle = 0; cycle < cycles; ++cycle) {
+        for (int input = 0; input < ports; ++input) {
+            if (gen.uniform() >= load) continue;
+            int output = gen.bounded(ports);
+            int level = pick_level(gen);
+            PacketHandle h = pool.allocate();
+            pool[h] = PriorityPacket{next_id++, static_cast<uint32_t>(cycle), static_cast<uint8_t>(level)};
+            if (!outputs[output].enqueue(h)) {
+                drops[level]++;
+                pool.release(h);
+            }
+        }
+        for (int output = 0; output < ports; ++output) {
+            PacketHandle h = outputs[output].dequeue(cycle);
+            if (h == NULL_HANDLE) continue;
+            delays[pool[h].level].record(cycle - pool[h].arrival_time);
+            pool.release(h);
+        }
+    }
+
+    std::cout << "\n" << name << " (" << ports << " ports, load " << load << ")\n";
+    std::cout << "level     sent    drops    p50    p99  p99.9    max\n";
+    for (int level = 0; level < LEVELS; ++level) {
+        const LatencyHistogram& d = delays[level];
+        std::cout << std::setw(5) << level << std::setw(9) << d.count() << std::setw(9) << drops[level]
+                  << std::setw(7) << d.percentile(0.50) << std::setw(7) << d.percentile(0.99)
+                  << std::setw(7) << d.percentile(0.999) << std::setw(7) << d.max() << "\n";
+    }
+}
+
+// Scaling model, as in priority.cpp: input-queued, and every cycle each
+// output takes the highest-priority head among all inputs (lowest input on
+// ties). Each input holds its packets in per-level FIFOs with a level bitmap
+// (StrictPriorityPort), so both selectors run on the same queue state, make
+// the same choices and differ only in how an output finds the input.
+
+// priority.cpp: look at every input's head.
+class ScanSelector {
+public:
+    explicit ScanSelector(int) {}
+    void update(int, int, int) {}
+
+    int pick(const std::vector<StrictPriorityPort>& inputs) const {
+        int best = -1, best_level = LEVELS;
+        for (int input = 0; input < static_cast<int>(inputs.size()); ++input) {
+            int level = inputs[input].top_level();
+            if (level >= 0 && level < best_level) {
+                best = input;
+                best_level = level;
+            }
+        }
+        return best;
+    }
+};
+
+// One bitmap of inputs per head level, plus a bitmap of the levels that
+// have any: the best input is a find-first-set on the levels and then on
+// that level's first non-zero word.
+class BitmapSelector {
+public:
+    explicit BitmapSelector(int ports)
+        : words((ports + 63) / 64), heads(LEVELS * words, 0), count(LEVELS, 0) {}
+
+    // `input`'s head level moved from old_level to new_level (-1: empty).
+    void update(int input, int old_level, int new_level) {
+        if (old_level == new_level) return;
+        uint64_t bit = uint64_t(1) << (input % 64);
+        if (old_level >= 0) {
+            heads[old_level * words + input / 64] &= ~bit;
+            if (--count[old_level] == 0) levels &= ~(uint64_t(1) << old_level);
+        }
+        if (new_level >= 0) {
+            heads[new_level * words + input / 64] |= bit;
+            if (count[new_level]++ == 0) levels |= uint64_t(1) << new_level;
+        }
+    }
+
+    int pick(const std::vector<StrictPriorityPort>&) const {
+        if (!levels) return -1;
+        const uint64_t* row = &heads[__builtin_ctzll(levels) * words];
+        int w = 0;
+        while (!row[w]) ++w;
+        return w * 64 + __builtin_ctzll(row[w]);
+    }
+
+private:
+    int words;
+    std::vector<uint64_t> heads; // LEVELS rows of `words` words
+    std::vector<int> count;      // inputs per head level
+    uint64_t levels = 0;
+};
+
+// ns per port-cycle; `checksum` summarizes which packet left on which output.
+template <class Selector>
+double run_selector(int ports, int cycles, double load, uint64_t& checksum) {
+    PriorityConfig config;
+    config.levels = LEVELS;
+    config.queue_limit = 256;
+    PacketPool<PriorityPacket> pool(ports * LEVELS * config.queue_limit);
+    std::vector<StrictPriorityPort> inputs(ports, StrictPriorityPort(config, pool));
+    Selector selector(ports);
+    CounterRng gen(7, 1);
+    uint32_t next_id = 0;
+    checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int cycle = 0; cycle < cycles; ++cycle) {
+        for (int input = 0; input < ports; ++input) {
+            if (gen.uniform() >= load) continue;
+            PacketHandle h = pool.allocate();
+            pool[h] = PriorityPacket{next_id++, static_cast<uint32_t>(cycle), static_cast<uint8_t>(pick_level(gen))};
+            int before = inputs[input].top_level();
+            if (!inputs[input].enqueue(h)) {
+                pool.release(h);
+                continue;
+            }
+            selector.update(input, before, inputs[input].top_level());
+        }
+        for (int output = 0; output < ports; ++output) {
+            int input = selector.pick(inputs);
+            if (input < 0) break; // every input is empty
+            int before = inputs[input].top_level();
+            PacketHandle h = inputs[input].dequeue(cycle);
+            selector.update(input, before, inputs[input].top_level());
+            checksum = checksum * 1000003 + pool[h].id * uint64_t(ports) + output;
+            pool.release(h);
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return seconds * 1e9 / (static_cast<double>(ports) * cycles);
+}
+
+int main(int argc, char* argv[]) {
+    int cycles = argc > 1 ? std::stoi(argv[1]) : 200000;
+    double load = argc > 2 ? std::stod(argv[2]) : 0.98;
+
+    latency_by_guard(GUARD_NONE, "Strict priority, no guard", 16, cycles, load);
+    latency_by_guard(GUARD_AGING, "Aging guard (200 cycles)", 16, cycles, load);
+    latency_by_guard(GUARD_WEIGHTED, "Weighted guard (1 in 16 grants)", 16, cycles, load);
+
+    std::cout << "\nScaling (ns per port-cycle, load " << load << ")\n";
+    std::cout << "ports   linear-scan   bitmap   same\n";
+    for (int ports : {8, 32, 128, 512, 1024}) {
+        // The scan is quadratic in ports; keep its total work bounded.
+        int scale_cycles = std::max(200, static_cast<int>(50000000LL / (static_cast<long long>(ports) * ports)));
+        uint64_t scan_sum, bitmap_sum;
+        double scan = run_selector<ScanSelector>(ports, scale_cycles, load, scan_sum);
+        double bitmap = run_selector<BitmapSelector>(ports, scale_cycles, load, bitmap_sum);
+        std::cout << std::setw(5) << ports << std::fixed << std::setprecision(1) << std::setw(14) << scan
+                  << std::setw(9) << bitmap << std::setw(7) << (scan_sum == bitmap_sum ? "yes" : "NO") << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,163 @@
+#include <iostream>
+#include <vector>
+#include <queue>
+#include <chrono>
+#include <iomanip>
+#include <string>
+#include "packet_pool.h"
+#include "perf_counter.h"
+#include "rng.h"
+
+// Simulator hot loop with the original queue layout (std::queue<Packet>,
+// packets copied by value) against the pool + ring buffer layout used by
+// fast_switch.h. Arrivals are pre-generated so only queue work is timed.
+// Usage: ./queue_bench [ports] [cycles] [load]
+
+constexpr int BUFFER_SIZE = 64;
+
+// Same fields as the Packet in iSLIP.cpp.
+struct Packet {
+    int id;
+    int input_port;
+    int output_port;
+    int arrival_time;
+    int departure_time;
+};
+
+struct Arrival {
+    int16_t output; // -1 if no packet this cycle
+};
+
+struct LoopResult {
+    double seconds;
+    uint64_t transmitted;
+    uint64_t delay_sum;
+};
+
+// Original layout: one std::queue<Packet> per port, hand-checked limits.
+LoopResult run_std_queue(int ports, int cycles, const std::vector<Arrival>& arrivals) {
+    std::vector<std::queue<Packet>> input_queues(ports), output_queues(ports);
+    std::vector<int> grant(ports), pointer(ports, 0);
+    LoopResult result{0, 0, 0};
+    int next_id = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int cycle = 0; cycle < cycles; ++cycle) {
+        const Arrival* a = &arrivals[static_cast<size_t>(cycle) * ports];
+        for (int i = 0; i < ports; ++i) {
+            if (a[i].output >= 0 && input_queues[i].size() < BUFFER_SIZE) {
+                input_queues[i].push(Packet{next_id++, i, a[i].output, cycle, -1});
+            }
+        }
+        std::fill(grant.begin(), grant.end(), -1);
+        for (int i = 0; i < ports; ++i) {
+            if (input_queues[i].empty()) continue;
+            int o = input_queues[i].front().output_port;
+            int d = i - pointer[o];
+            if (d < 0) d += ports;
+            int g = grant[o];
+            int dg = g - pointer[o];
+            if (dg < 0) dg += ports;
+            if (g == -1 || d < dg) grant[o] = i;
+        }
+        for (int o = 0; o < ports; ++o) {
+            if (grant[o] != -1) {
+                Packet packet = input_queues[grant[o]].front();
+                input_queues[grant[o]].pop();
+                output_queues[o].push(packet);
+                pointer[o] = grant[o] + 1 == ports ? 0 : grant[o] + 1;
+            }
+            if (!output_queues[o].empty()) {
+                Packet packet = output_queues[o].front();
+                output_queues[o].pop();
+                result.transmitted++;
+                result.delay_sum += cycle - packet.arrival_time;
+            }
+        }
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+// Pool + ring layout: queues hold 32-bit handles, capacity is structural.
+LoopResult run_ring_pool(int ports, int cycles, const std::vector<Arrival>& arrivals) {
+    PacketPool<Packet> pool(2 * ports * BUFFER_SIZE);
+    std::vector<RingQueue> input_queues(ports, RingQueue(BUFFER_SIZE));
+    std::vector<RingQueue> output_queues(ports, RingQueue(BUFFER_SIZE));
+    std::vector<int> grant(ports), pointer(ports, 0);
+    LoopResult result{0, 0, 0};
+    int next_id = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int cycle = 0; cycle < cycles; ++cycle) {
+        const Arrival* a = &arrivals[static_cast<size_t>(cycle) * ports];
+        for (int i = 0; i < ports; ++i) {
+            if (a[i].output >= 0 && !input_queues[i].full()) {
+                PacketHandle h = pool.allocate();
+                pool[h] = Packet{next_id++, i, a[i].output, cycle, -1};
+                input_queues[i].push(h);
+            }
+        }
+        std::fill(grant.begin(), grant.end(), -1);
+        for (int i = 0; i < ports; ++i) {
+            if (input_queues[i].empty()) continue;
+            int o = pool[input_queues[i].front()].output_port;
+            int d = i - pointer[o];
+            if (d < 0) d += ports;
+            int g = grant[o];
+            int dg = g - pointer[o];
+            if (dg < 0) dg += ports;
+            if (g == -1 || d < dg) grant[o] = i;
+        }
+        for (int o = 0; o < ports; ++o) {
+            if (grant[o] != -1) {
+                output_queues[o].push(input_queues[grant[o]].pop());
+                pointer[o] = grant[o] + 1 == ports ? 0 : grant[o] + 1;
+            }
+            if (!output_queues[o].empty()) {
+                PacketHandle h = output_queues[o].pop();
+                result.transmitted++;
+                result.delay_sum += cycle - pool[h].arrival_time;
+                pool.release(h);
+            }
+        }
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+template <typename Loop>
+void measure(const std::string& name, Loop loop, int ports, int cycles, const std::vector<Arrival>& arrivals) {
+    PerfCounter misses(PerfCounter::CACHE_MISSES);
+    misses.start();
+    LoopResult r = loop(ports, cycles, arrivals);
+    uint64_t miss_count = misses.stop();
+
+    double port_cycles = static_cast<double>(ports) * cycles;
+    std::cout << std::left << std::setw(22) << name << std::right << std::fixed
+              << std::setprecision(2) << std::setw(8) << port_cycles / r.seconds / 1e6 << " M port-cycles/s";
+    if (misses.available()) {
+        std::cout << std::setw(10) << std::setprecision(3) << miss_count / port_cycles << " cache misses/port-cycle";
+    } else {
+        std::cout << "   (cache-miss counter unavailable)";
+    }
+    std::cout << "  [transmitted " << r.transmitted << ", avg delay "
+              << std::setprecision(2) << static_cast<double>(r.delay_sum) / r.transmitted << "]\n";
+}
+
+int main(int argc, char* argv[]) {
+    int ports = argc > 1 ? std::stoi(argv[1]) : 64;
+    int cycles = argc > 2 ? std::stoi(argv[2]) : 200000;
+    double load = argc > 3 ? std::stod(argv[3]) : 0.9;
+
+    CounterRng gen(1, 0);
+    std::vector<Arrival> arrivals(static_cast<size_t>(ports) * cycles);
+    for (Arrival& a : arrivals) {
+        a.output = gen.uniform() < load ? static_cast<int16_t>(gen.bounded(ports)) : -1;
+    }
+
+    std::cout << "Ports: " << ports << ", cycles: " << cycles << ", load: " << load << "\n";
+    measure("std::queue<Packet>", run_std_queue, ports, cycles, arrivals);
+    measure("ring + packet pool", run_ring_pool, ports, cycles, arrivals);
+    return 0;
+}
@@ -0,0 +1,77 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <cstdint>
+
+// Counter-based generator (Philox4x32-10, Salmon et al., SC'11). Output is a
+// pure function of (key, counter), so every run in a sweep gets its own
+// independent, reproducible stream just by using a different stream id, with
+// no shared state between threads and no seeding cost.
+class CounterRng {
+public:
+    using result_type = uint64_t;
+
+    CounterRng(uint64_t seed = 0, uint64_t stream = 0) {
+        key[0] = static_cast<uint32_t>(seed);
+        key[1] = static_cast<uint32_t>(seed >> 32);
+        counter[0] = 0;
+        counter[1] = 0;
+        counter[2] = static_cast<uint32_t>(stream);
+        counter[3] = static_cast<uint32_t>(stream >> 32);
+    }
+
+    static constexpr uint64_t min() { return 0; }
+    static constexpr uint64_t max() { return UINT64_MAX; }
+
+    uint64_t operator()() {
+        if (available == 0) {
+            refill();
+            available = 2;
+        }
+        available--;
+        return available ? block[0] : block[1];
+    }
+
+    // Uniform double in [0, 1).
+    double uniform() {
+        return ((*this)() >> 11) * 0x1.0p-53;
+    }
+
+    // Uniform integer in [0, n) via multiply-shift.
+    uint32_t bounded(uint32_t n) {
+        return static_cast<uint32_t>((((*this)() >> 32) * n) >> 32);
+    }
+
+private:
+    static void mulhilo(uint32_t a, uint32_t b, uint32_t& hi, uint32_t& lo) {
+        uint64_t product = static_cast<uint64_t>(a) * b;
+        hi = static_cast<uint32_t>(product >> 32);
+        lo = static_cast<uint32_t>(product);
+    }
+
+    void refill() {
+        uint32_t x[4] = {counter[0], counter[1], counter[2], counter[3]};
+        uint32_t k0 = key[0], k1 = key[1];
+        for (int round = 0; round < 10; ++round) {
+            uint32_t hi0, lo0, hi1, lo1;
+            mulhilo(0xD2511F53u, x[0], hi0, lo0);
+            mulhilo(0xCD9E8D57u, x[2], hi1, lo1);
+            x[0] = hi1 ^ x[1] ^ k0;
+            x[1] = lo1;
+            x[2] = hi0 ^ x[3] ^ k1;
+            x[3] = lo0;
+            k0 += 0x9E3779B9u;
+            k1 += 0xBB67AE85u;
+        }
+        block[0] = (static_cast<uint64_t>(x[1]) << 32) | x[0];
+        block[1] = (static_cast<uint64_t>(x[3]) << 32) | x[2];
+        if (++counter[0] == 0) counter[1]++; // low 64 bits count blocks
+    }
+
+    uint32_t key[2];
+    uint32_t counter[4];
+    uint64_t block[2] = {0, 0};
+    int available = 0;
+};
+
+#endif
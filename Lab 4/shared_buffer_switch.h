@@ -0,0 +1,111 @@
+#ifndef SHARED_BUFFER_SWITCH_H
+#define SHARED_BUFFER_SWITCH_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "packet_pool.h"
+#include "sim_stats.h"
+#include "traffic.h"
+
+// Shared-memory output-queued switch: every arrival is written straight
+// into its output queue (the ideal, speedup-N fabric) and all output queues
+// draw from one buffer of `buffer_size` packets. The admission policy
+// decides how that memory is shared:
+//   static     - each output owns buffer_size / N packets
+//   complete   - any output may use the whole buffer while it lasts
+//   dynamic    - Choudhury-Hahne dynamic threshold: an output may grow while
+//                its queue is below alpha * (free buffer), so a few busy
+//                outputs cannot lock everyone else out.
+
+enum BufferPolicy { BUFFER_STATIC, BUFFER_COMPLETE, BUFFER_DYNAMIC };
+
+struct SharedBufferConfig {
+    int num_ports = 32;
+    int buffer_size = 1024;     // packets, shared by all outputs
+    BufferPolicy policy = BUFFER_DYNAMIC;
+    double alpha = 1.0;         // dynamic threshold factor
+    uint64_t cycles = 100000;
+    uint64_t seed = 1;
+    uint64_t stream = 0;
+    TrafficConfig traffic;
+};
+
+struct SharedBufferPacket {
+    uint32_t arrival_time;
+    uint32_t traffic_class;
+};
+
+class SharedBufferSwitch {
+public:
+    explicit SharedBufferSwitch(const SharedBufferConfig& config)
+        : config(config), n(config.num_ports), stats(config.num_ports, config.traffic.num_classes),
+          traffic(config.traffic, config.num_ports, config.seed, config.stream),
+          pool(static_cast<uint32_t>(config.buffer_size)),
+          output_queues(config.num_ports, RingQueue(config.buffer_size)),
+          static_share(config.buffer_size / config.num_ports) {}
+
+    void run() {
+        for (uint64_t cycle = 0; cycle < config.cycles; ++cycle) {
+            step(cycle);
+        }
+        stats.cycles += config.cycles;
+    }
+
+    const SimStats& get_stats() const { return stats; }
+    uint64_t peak_occupancy() const { return peak; }
+
+private:
+    void step(uint64_t cycle) {
+        traffic.generate(cycle, [&](int input, int output, int traffic_class) {
+            stats.generated++;
+            if (!admit(output)) {
+                stats.record_drop(input);
+                return;
+            }
+            PacketHandle handle = pool.allocate();
+            pool[handle] = SharedBufferPacket{static_cast<uint32_t>(cycle), static_cast<uint32_t>(traffic_class)};
+            output_queues[output].push(handle);
+            if (++occupancy > peak) peak = occupancy;
+        });
+
+        for (int output = 0; output < n; ++output) {
+            RingQueue& queue = output_queues[output];
+            if (queue.empty()) continue;
+            PacketHandle handle = queue.pop();
+            stats.record_departure(output, cycle - pool[handle].arrival_time, pool[handle].traffic_class);
+            pool.release(handle);
+            occupancy--;
+        }
+    }
+
+    bool admit(int output) const {
+        if (occupancy >= static_cast<uint64_t>(config.buffer_size)) return false;
+        uint32_t length = output_queues[output].size();
+        switch (config.policy) {
+            case BUFFER_STATIC: return length < static_share;
+            case BUFFER_COMPLETE: return true;
+            default: return length < config.alpha * (config.buffer_size - occupancy);
+        }
+    }
+
+    SharedBufferConfig config;
+    int n;
+    SimStats stats;
+    TrafficGenerator traffic;
+    PacketPool<SharedBufferPacket> pool;
+    std::vector<RingQueue> output_queues;
+    uint32_t static_share;
+    uint64_t occupancy = 0;
+    uint64_t peak = 0;
+};
+
+inline bool parse_buffer_policy(const std::string& name, BufferPolicy& out) {
+    if (name == "static") out = BUFFER_STATIC;
+    else if (name == "complete") out = BUFFER_COMPLETE;
+    else if (name == "dynamic") out = BUFFER_DYNAMIC;
+    else return false;
+    return true;
+}
+
+#endif
@@ -0,0 +1,160 @@
+#ifndef SIM_STATS_H
+#define SIM_STATS_H
+
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "latency_histogram.h"
+
+// Compact counters for the headless simulators. Everything is a plain integer
+// so the hot loop only does increments; ratios are derived when printing.
+struct SimStats {
+    uint64_t cycles = 0;
+    uint64_t generated = 0;
+    uint64_t dropped = 0;     // rejected at a full input buffer
+    uint64_t transmitted = 0;
+    uint64_t total_delay = 0; // sum of (departure - arrival) over transmitted packets
+    uint64_t max_delay = 0;
+    std::vector<uint64_t> transmitted_per_port;
+    std::vector<uint64_t> dropped_per_port;
+    std::vector<LatencyHistogram> delay_by_port;  // queueing delay by output port
+    std::vector<LatencyHistogram> delay_by_class; // by traffic class (empty if unclassified)
+
+    explicit SimStats(int num_ports = 0, int num_classes = 0)
+        : transmitted_per_port(num_ports, 0), dropped_per_port(num_ports, 0),
+          delay_by_port(num_ports), delay_by_class(num_classes) {}
+
+    void record_departure(int port, uint64_t delay, int traffic_class = -1) {
+        transmitted++;
+        transmitted_per_port[port]++;
+        total_delay += delay;
+        if (delay > max_delay) max_delay = delay;
+        delay_by_port[port].record(delay);
+        if (traffic_class >= 0 && traffic_class < static_cast<int>(delay_by_class.size())) {
+            delay_by_class[traffic_class].record(delay);
+        }
+    }
+
+    void record_drop(int port) {
+        dropped++;
+        dropped_per_port[port]++;
+    }
+
+    void merge(const SimStats& other) {
+        cycles += other.cycles;
+        generated += other.generated;
+        dropped += other.dropped;
+        transmitted += other.transmitted;
+        total_delay += other.total_delay;
+        if (other.max_delay > max_delay) max_delay = other.max_delay;
+        if (transmitted_per_port.size() < other.transmitted_per_port.size()) {
+            transmitted_per_port.resize(other.transmitted_per_port.size(), 0);
+            dropped_per_port.resize(other.dropped_per_port.size(), 0);
+        }
+        for (size_t i = 0; i < other.transmitted_per_port.size(); ++i) {
+            transmitted_per_port[i] += other.transmitted_per_port[i];
+            dropped_per_port[i] += other.dropped_per_port[i];
+        }
+        if (delay_by_port.size() < other.delay_by_port.size()) delay_by_port.resize(other.delay_by_port.size());
+        for (size_t i = 0; i < other.delay_by_port.size(); ++i) delay_by_port[i].merge(other.delay_by_port[i]);
+        if (delay_by_class.size() < other.delay_by_class.size()) delay_by_class.resize(other.delay_by_class.size());
+        for (size_t i = 0; i < other.delay_by_class.size(); ++i) delay_by_class[i].merge(other.delay_by_class[i]);
+    }
+
+    // Fraction of output-port capacity used over the run.
+    double throughput() const {
+        uint64_t slots = cycles * transmitted_per_port.size();
+        return slots ? static_cast<double>(transmitted) / slots : 0.0;
+    }
+
+    double loss_rate() const {
+        return generated ? static_cast<double>(dropped) / generated : 0.0;
+    }
+
+    double average_delay() const {
+        return transmitted ? static_cast<double>(total_delay) / transmitted : 0.0;
+    }
+
+    // Delay histogram over all ports, merged on demand to keep recording cheap.
+    LatencyHistogram delay_histogram() const {
+        LatencyHistogram all;
+        for (const LatencyHistogram& h : delay_by_port) all.merge(h);
+        return all;
+    }
+
+    void print(std::ostream& out) const {
+        LatencyHistogram all = delay_histogram();
+        out << "Cycles: " << cycles << "\n"
+            << "Packets Generated: " << generated << "\n"
+            << "Packets Transmitted: " << transmitted << "\n"
+            << "Packets Dropped: " << dropped << "\n"
+            << std::fixed << std::setprecision(4)
+            << "Throughput: " << throughput() * 100 << "%\n"
+            << "Loss Rate: " << loss_rate() * 100 << "%\n"
+            << "Average Delay: " << average_delay() << " cycles\n"
+            << "Delay p50/p99/p99.9: " << all.percentile(0.50) << " / "
+            << all.percentile(0.99) << " / " << all.percentile(0.999) << " cycles\n"
+            << "Max Delay: " << max_delay << " cycles\n";
+    }
+
+    // Per-port and per-class delay percentiles.
+    void print_latency(std::ostream& out) const {
+        LatencyHistogram::print_header(out);
+        delay_histogram().print(out, "all");
+        for (size_t i = 0; i < delay_by_port.size(); ++i) {
+            delay_by_port[i].print(out, ("port " + std::to_string(i)).c_str());
+        }
+        for (size_t i = 0; i < delay_by_class.size(); ++i) {
+            delay_by_class[i].print(out, ("class " + std::to_string(i)).c_str());
+        }
+    }
+};
+
+enum TraceEventType : uint8_t { EVENT_ARRIVAL, EVENT_DROP, EVENT_GRANT, EVENT_DEPARTURE };
+
+struct TraceEvent {
+    uint64_t cycle;
+    uint32_t packet_id;
+    uint16_t port;
+    uint8_t type;
+};
+
+// Sampled event trace: keeps every Nth event in a fixed-size ring, so
+// tracing a long run costs a counter check per event and bounded memory.
+// sample_every = 0 disables tracing entirely.
+class EventTrace {
+public:
+    EventTrace(uint64_t sample_every = 0, size_t capacity = 1 << 16)
+        : sample_every(sample_every), countdown(sample_every), events(sample_every ? capacity : 0) {}
+
+    bool enabled() const { return sample_every != 0; }
+
+    void record(uint64_t cycle, uint32_t packet_id, int port, TraceEventType type) {
+        if (!sample_every || --countdown != 0) return;
+        countdown = sample_every;
+        events[written % events.size()] = TraceEvent{cycle, packet_id, static_cast<uint16_t>(port), type};
+        written++;
+    }
+
+    // Writes the retained events, oldest first, one per line.
+    void dump(std::ostream& out) const {
+        static const char* names[] = {"arrival", "drop", "grant", "departure"};
+        size_t count = written < events.size() ? written : events.size();
+        size_t first = written - count;
+        for (size_t i = 0; i < count; ++i) {
+            const TraceEvent& e = events[(first + i) % events.size()];
+            out << e.cycle << " " << names[e.type] << " packet " << e.packet_id
+                << " port " << e.port << "\n";
+        }
+    }
+
+private:
+    uint64_t sample_every;
+    uint64_t countdown;
+    size_t written = 0;
+    std::vector<TraceEvent> events;
+};
+
+#endif
@@ -0,0 +1,96 @@
+#ifndef STRICT_PRIORITY_H
+#define STRICT_PRIORITY_H
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+#include "packet_pool.h"
+
+// Multi-level strict-priority scheduler for one output port. Level 0 is the
+// highest priority. Each level is a FIFO ring, and a 64-bit bitmap marks the
+// non-empty levels so the next level is one find-first-set instead of a scan
+// over inputs as in priority.cpp. Packets of equal priority leave in arrival
+// order.
+
+constexpr int MAX_PRIORITY_LEVELS = 64;
+
+enum StarvationGuard {
+    GUARD_NONE,     // pure strict priority; low levels can starve
+    GUARD_AGING,    // a head packet older than aging_threshold is served first
+    GUARD_WEIGHTED  // every guard_interval-th grant goes to the lowest non-empty level
+};
+
+struct PriorityConfig {
+    int levels = 8;
+    uint32_t queue_limit = 64;     // per level
+    StarvationGuard guard = GUARD_NONE;
+    uint32_t aging_threshold = 100; // cycles (GUARD_AGING)
+    uint32_t guard_interval = 16;   // grants (GUARD_WEIGHTED)
+};
+
+struct PriorityPacket {
+    uint32_t id;
+    uint32_t arrival_time;
+    uint8_t level;
+};
+
+class StrictPriorityPort {
+public:
+    StrictPriorityPort(const PriorityConfig& config, PacketPool<PriorityPacket>& pool)
+        : config(config), pool(pool), queues(config.levels, RingQueue(config.queue_limit)) {
+        // One bit per level in the non-empty bitmap
+        assert(config.levels >= 1 && config.levels <= MAX_PRIORITY_LEVELS);
+    }
+
+    // Returns false (packet dropped) if the packet's level is full.
+    bool enqueue(PacketHandle handle) {
+        int level = pool[handle].level;
+        if (!queues[level].push(handle)) return false;
+        nonempty |= uint64_t(1) << level;
+        return true;
+    }
+
+    // Picks the next packet to send, or NULL_HANDLE if the port is idle.
+    PacketHandle dequeue(uint32_t now) {
+        if (!nonempty) return NULL_HANDLE;
+        int level = __builtin_ctzll(nonempty);
+
+        if (config.guard == GUARD_WEIGHTED) {
+            if (++grants_since_guard >= config.guard_interval) {
+                grants_since_guard = 0;
+                level = 63 - __builtin_clzll(nonempty); // lowest non-empty level
+            }
+        } else if (config.guard == GUARD_AGING) {
+            // Only levels below the top can be starving. Walk them from the
+            // lowest priority up and serve the first head past the threshold;
+            // the cost is the number of non-empty levels, at most 64.
+            uint64_t lower = nonempty & ~(uint64_t(1) << level);
+            while (lower) {
+                int candidate = 63 - __builtin_clzll(lower);
+                if (now - pool[queues[candidate].front()].arrival_time > config.aging_threshold) {
+                    level = candidate;
+                    break;
+                }
+                lower &= ~(uint64_t(1) << candidate);
+            }
+        }
+
+        PacketHandle handle = queues[level].pop();
+        if (queues[level].empty()) nonempty &= ~(uint64_t(1) << level);
+        return handle;
+    }
+
+    bool empty() const { return nonempty == 0; }
+    // Highest non-empty level, or -1 if the port is idle.
+    int top_level() const { return nonempty ? __builtin_ctzll(nonempty) : -1; }
+    uint32_t backlog(int level) const { return queues[level].size(); }
+
+private:
+    PriorityConfig config;
+    PacketPool<PriorityPacket>& pool;
+    std::vector<RingQueue> queues;
+    uint64_t nonempty = 0;
+    uint32_t grants_since_guard = 0;
+};
+
+#endif
@@ -0,0 +1,237 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <cmath>
+#include <iomanip>
+#include "fast_switch.h"
+
+// Parallel Monte Carlo sweep over scheduler x traffic pattern x load x ports.
+// Every grid point is run with --seeds independent RNG streams; runs are
+// spread across --threads workers and reduced to mean and 95% confidence
+// intervals.
+//
+// Example:
+//   ./sweep --schedulers islip,rr,priority --patterns uniform,bursty
+//           --loads 0.1:0.9:0.1 --ports 8,16 --seeds 16 --cycles 200000
+//           --csv sweep.csv --json sweep.json
+
+struct GridPoint {
+    SchedulerType scheduler;
+    std::string pattern;
+    double load;
+    int ports;
+};
+
+struct RunResult {
+    double throughput;
+    double loss_rate;
+    double average_delay;
+    double p99_delay;
+};
+
+struct Summary {
+    double mean;
+    double half_width; // 95% confidence interval is mean +/- half_width
+};
+
+const char* scheduler_name(SchedulerType s) {
+    switch (s) {
+        case SCHED_ISLIP: return "islip";
+        case SCHED_ROUND_ROBIN: return "rr";
+        default: return "priority";
+    }
+}
+
+std::vector<std::string> split(const std::string& text, char sep) {
+    std::vector<std::string> parts;
+    std::stringstream in(text);
+    std::string part;
+    while (std::getline(in, part, sep)) {
+        if (!part.empty()) parts.push_back(part);
+    }
+    return parts;
+}
+
+// Accepts "0.2,0.5,0.8" or a range "start:stop:step".
+std::vector<double> parse_loads(const std::string& text) {
+    std::vector<double> loads;
+    std::vector<std::string> range = split(text, ':');
+    if (range.size() == 3) {
+        double start = std::stod(range[0]), stop = std::stod(range[1]), step = std::stod(range[2]);
+        for (int i = 0; start + i * step <= stop + 1e-9; ++i) {
+            loads.push_back(start + i * step);
+        }
+        return loads;
+    }
+    for (const std::string& part : split(text, ',')) {
+        loads.push_back(std::stod(part));
+    }
+    return loads;
+}
+
+// Two-sided 95% Student t quantile for n - 1 degrees of freedom.
+double t_quantile(int n) {
+    static const double table[] = {0, 12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306,
+                                   2.262, 2.228, 2.201, 2.179, 2.160, 2.145, 2.131, 2.120,
+                                   2.110, 2.101, 2.093, 2.086, 2.080, 2.074, 2.069, 2.064,
+                                   2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+    int df = n - 1;
+    if (df <= 0) return 0;
+    return df <= 30 ? table[df] : 1.96;
+}
+
+Summary summarize(const std::vector<RunResult>& runs, double RunResult::*field) {
+    int n = static_cast<int>(runs.size());
+    double sum = 0;
+    for (const RunResult& r : runs) sum += r.*field;
+    double mean = sum / n;
+    double sq = 0;
+    for (const RunResult& r : runs) sq += (r.*field - mean) * (r.*field - mean);
+    double stddev = n > 1 ? std::sqrt(sq / (n - 1)) : 0;
+    return Summary{mean, t_quantile(n) * stddev / std::sqrt(static_cast<double>(n))};
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<SchedulerType> schedulers = {SCHED_ISLIP, SCHED_ROUND_ROBIN, SCHED_PRIORITY};
+    std::vector<std::string> patterns = {"uniform", "non-uniform", "bursty"};
+    std::vector<double> loads = parse_loads("0.1:0.9:0.2");
+    std::vector<int> port_counts = {8};
+    int seeds = 8;
+    uint64_t cycles = 100000;
+    uint64_t base_seed = 2024;
+    int num_threads = static_cast<int>(std::thread::hardware_concurrency());
+    std::string csv_file = "sweep.csv";
+    std::string json_file;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--schedulers" && i + 1 < argc) {
+            schedulers.clear();
+            for (const std::string& name : split(argv[++i], ',')) {
+                SchedulerType s;
+                if (!parse_scheduler(name, s)) {
+                    std::cerr << "Unknown scheduler: " << name << "\n";
+                    return 1;
+                }
+                schedulers.push_back(s);
+            }
+        } else if (arg == "--patterns" && i + 1 < argc) {
+            patterns = split(argv[++i], ',');
+            for (const std::string& name : patterns) {
+                TrafficConfig traffic;
+                if (!parse_traffic(name, traffic)) {
+                    std::cerr << "Unknown traffic pattern: " << name << "\n";
+                    return 1;
+                }
+            }
+        } else if (arg == "--loads" && i + 1 < argc) {
+            loads = parse_loads(argv[++i]);
+        } else if (arg == "--ports" && i + 1 < argc) {
+            port_counts.clear();
+            for (const std::string& part : split(argv[++i], ',')) {
+                port_counts.push_back(std::stoi(part));
+            }
+        } else if (arg == "--seeds" && i + 1 < argc) {
+            seeds = std::stoi(argv[++i]);
+            if (seeds < 1) {
+                std::cerr << "--seeds must be at least 1\n";
+                return 1;
+            }
+        } else if (arg == "--cycles" && i + 1 < argc) {
+            cycles = std::stoull(argv[++i]);
+        } else if (arg == "--seed" && i + 1 < argc) {
+            base_seed = std::stoull(argv[++i]);
+        } else if (arg == "--threads" && i + 1 < argc) {
+            num_threads = std::stoi(argv[++i]);
+        } else if (arg == "--csv" && i + 1 < argc) {
+            csv_file = argv[++i];
+        } else if (arg == "--json" && i + 1 < argc) {
+            json_file = argv[++i];
+        }
+    }
+    if (num_threads < 1) num_threads = 1;
+
+    std::vector<GridPoint> grid;
+    for (SchedulerType s : schedulers)
+        for (const std::string& p : patterns)
+            for (double load : loads)
+                for (int ports : port_counts)
+                    grid.push_back(GridPoint{s, p, load, ports});
+
+    // One slot per (grid point, seed); workers claim runs through an atomic
+    // index and write only their own slots, so no locking is needed.
+    size_t total_runs = grid.size() * seeds;
+    std::vector<RunResult> results(total_runs);
+    std::atomic<size_t> next_run{0};
+
+    auto worker = [&]() {
+        for (size_t run = next_run++; run < total_runs; run = next_run++) {
+            const GridPoint& point = grid[run / seeds];
+            SimConfig config;
+            config.scheduler = point.scheduler;
+            parse_traffic(point.pattern, config.traffic);
+            config.traffic.load = point.load;
+            config.num_ports = point.ports;
+            config.cycles = cycles;
+            config.seed = base_seed;
+            // The stream depends on the load point and seed index but not on the
+            // scheduler, so every scheduler is fed the same arrivals.
+            config.stream = (run / seeds % (patterns.size() * loads.size() * port_counts.size())) * seeds + run % seeds;
+
+            FastSwitch fabric(config);
+            fabric.run();
+            const SimStats& stats = fabric.get_stats();
+            results[run] = RunResult{stats.throughput(), stats.loss_rate(), stats.average_delay(),
+                                     static_cast<double>(stats.delay_histogram().percentile(0.99))};
+        }
+    };
+
+    std::cout << "Running " << total_runs << " simulations (" << grid.size() << " grid points x "
+              << seeds << " seeds) on " << num_threads << " threads\n";
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t) threads.emplace_back(worker);
+    for (std::thread& t : threads) t.join();
+
+    std::ofstream csv(csv_file);
+    csv << "scheduler,pattern,load,ports,seeds,throughput,throughput_ci,loss_rate,loss_rate_ci,avg_delay,avg_delay_ci,p99_delay,p99_delay_ci\n";
+    std::ofstream json;
+    if (!json_file.empty()) {
+        json.open(json_file);
+        json << "[\n";
+    }
+
+    csv << std::setprecision(6);
+    json << std::setprecision(6);
+    for (size_t g = 0; g < grid.size(); ++g) {
+        std::vector<RunResult> runs(results.begin() + g * seeds, results.begin() + (g + 1) * seeds);
+        Summary throughput = summarize(runs, &RunResult::throughput);
+        Summary loss = summarize(runs, &RunResult::loss_rate);
+        Summary delay = summarize(runs, &RunResult::average_delay);
+        Summary p99 = summarize(runs, &RunResult::p99_delay);
+        const GridPoint& p = grid[g];
+
+        csv << scheduler_name(p.scheduler) << "," << p.pattern << "," << p.load << ","
+            << p.ports << "," << seeds << "," << throughput.mean << "," << throughput.half_width << ","
+            << loss.mean << "," << loss.half_width << "," << delay.mean << "," << delay.half_width << ","
+            << p99.mean << "," << p99.half_width << "\n";
+
+        if (json.is_open()) {
+            json << "  {\"scheduler\": \"" << scheduler_name(p.scheduler) << "\", \"pattern\": \""
+                 << p.pattern << "\", \"load\": " << p.load << ", \"ports\": " << p.ports
+                 << ", \"seeds\": " << seeds
+                 << ", \"throughput\": {\"mean\": " << throughput.mean << ", \"ci95\": " << throughput.half_width << "}"
+                 << ", \"loss_rate\": {\"mean\": " << loss.mean << ", \"ci95\": " << loss.half_width << "}"
+                 << ", \"avg_delay\": {\"mean\": " << delay.mean << ", \"ci95\": " << delay.half_width << "}"
+                 << ", \"p99_delay\": {\"mean\": " << p99.mean << ", \"ci95\": " << p99.half_width << "}}"
+                 << (g + 1 < grid.size() ? "," : "") << "\n";
+        }
+    }
+    if (json.is_open()) json << "]\n";
+
+    std::cout << "Results written to " << csv_file << (json_file.empty() ? "" : " and " + json_file) << "\n";
+    return 0;
+}
@@ -0,0 +1,297 @@
+#ifndef TRAFFIC_H
+#define TRAFFIC_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "rng.h"
+
+// Traffic sources shared by every Lab 4 scheduler. A generator is driven one
+// cycle at a time and reports each arrival as (input, output, class) through a
+// callback, so nothing is allocated per packet and any two schedulers given
+// the same config, seed and stream see exactly the same arrivals. Loss is left
+// entirely to the switch (buffer overflow); sources never drop packets.
+
+enum ArrivalProcess {
+    ARRIVAL_BERNOULLI, // i.i.d. arrival with probability `load` per input per cycle
+    ARRIVAL_ONOFF,     // two-state Markov chain: back-to-back packets while ON
+    ARRIVAL_TRACE      // replay of a captured packet trace
+};
+
+enum DestinationPattern {
+    DEST_UNIFORM,  // every output equally likely
+    DEST_HOTSPOT,  // hotspot_fraction of packets to hotspot_port, the rest uniform
+    DEST_DIAGONAL  // diagonal_fraction to output i, the rest to output i+1
+};
+
+struct TrafficConfig {
+    ArrivalProcess arrivals = ARRIVAL_BERNOULLI;
+    DestinationPattern destinations = DEST_UNIFORM;
+    double load = 0.8;
+    double mean_burst = 16.0;        // mean ON period in packets (ARRIVAL_ONOFF)
+    int hotspot_port = 0;
+    double hotspot_fraction = 0.5;
+    double diagonal_fraction = 2.0 / 3.0;
+    int num_classes = 10;            // traffic classes for priority schedulers
+};
+
+// A packet trace reduced to switch arrivals. Input and output ports come from
+// hashing the IPv4 source/destination (or MAC addresses for non-IP frames)
+// and timestamps are quantized to cycles of cycle_us microseconds. Loading
+// allocates; replay does not.
+class PacketTrace {
+public:
+    struct Record {
+        uint64_t cycle;
+        uint32_t src_hash;
+        uint32_t dst_hash;
+        uint8_t traffic_class;
+    };
+
+    // Reads a classic libpcap file (Ethernet, raw 802.11 or radiotap 802.11).
+    bool load_pcap(const std::string& path, double cycle_us = 1.0) {
+        FILE* file = std::fopen(path.c_str(), "rb");
+        if (!file) return false;
+
+        unsigned char header[24];
+        if (std::fread(header, 1, 24, file) != 24) {
+            std::fclose(file);
+            return false;
+        }
+        uint32_t magic = read32(header, false);
+        bool swapped;
+        bool nanosecond = false;
+        if (magic == 0xa1b2c3d4 || magic == 0xa1b23c4d) {
+            swapped = false;
+            nanosecond = magic == 0xa1b23c4d;
+        } else if (magic == 0xd4c3b2a1 || magic == 0x4d3cb2a1) {
+            swapped = true;
+            nanosecond = magic == 0x4d3cb2a1;
+        } else {
+            std::fclose(file);
+            return false;
+        }
+        uint32_t link_type = read32(header + 20, swapped);
+
+        std::vector<unsigned char> frame;
+        unsigned char record_header[16];
+        double first_us = -1;
+        while (std::fread(record_header, 1, 16, file) == 16) {
+            uint32_t seconds = read32(record_header, swapped);
+            uint32_t fraction = read32(record_header + 4, swapped);
+            uint32_t captured = read32(record_header + 8, swapped);
+            frame.resize(captured);
+            if (captured && std::fread(frame.data(), 1, captured, file) != captured) break;
+
+            double us = seconds * 1e6 + (nanosecond ? fraction / 1000.0 : fraction);
+            if (first_us < 0) first_us = us;
+
+            Record record;
+            if (!classify(frame, link_type, record)) continue;
+            record.cycle = static_cast<uint64_t>((us - first_us) / cycle_us);
+            records.push_back(record);
+        }
+        std::fclose(file);
+        return !records.empty();
+    }
+
+    const std::vector<Record>& get_records() const { return records; }
+
+private:
+    static uint32_t read32(const unsigned char* p, bool swapped) {
+        uint32_t little = p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24);
+        uint32_t big = p[3] | (p[2] << 8) | (p[1] << 16) | (static_cast<uint32_t>(p[0]) << 24);
+        // pcap headers are written in the capturing host's byte order; the
+        // magic number tells us whether that matches little-endian.
+        return swapped ? big : little;
+    }
+
+    static uint32_t hash_bytes(const unsigned char* p, int n) {
+        uint32_t h = 2166136261u; // FNV-1a
+        for (int i = 0; i < n; ++i) {
+            h = (h ^ p[i]) * 16777619u;
+        }
+        return h;
+    }
+
+    // Finds the addresses to hash: IPv4 source/destination if the frame
+    // carries IP, otherwise the link-layer transmitter/receiver.
+    static bool classify(const std::vector<unsigned char>& frame, uint32_t link_type, Record& out) {
+        size_t n = frame.size();
+        size_t offset = 0;
+        size_t src_mac, dst_mac, payload;
+        uint32_t ethertype;
+
+        if (link_type == 127) { // radiotap: skip the variable-length header
+            if (n < 4) return false;
+            offset = frame[2] | (frame[3] << 8);
+            link_type = 105;
+        }
+        if (link_type == 1) { // Ethernet
+            if (n < offset + 14) return false;
+            dst_mac = offset;
+            src_mac = offset + 6;
+            ethertype = (frame[offset + 12] << 8) | frame[offset + 13];
+            payload = offset + 14;
+        } else if (link_type == 105) { // 802.11 data frame with LLC/SNAP
+            if (n < offset + 24) return false;
+            uint8_t frame_control = frame[offset];
+            dst_mac = offset + 4;  // addr1: receiver
+            src_mac = offset + 10; // addr2: transmitter
+            size_t header_len = 24;
+            if ((frame_control & 0x0c) == 0x08 && (frame_control & 0x80)) header_len += 2; // QoS data
+            payload = offset + header_len + 8;
+            ethertype = 0;
+            if (n >= payload && frame[payload - 8] == 0xaa && frame[payload - 7] == 0xaa) {
+                ethertype = (frame[payload - 2] << 8) | frame[payload - 1];
+            }
+        } else {
+            return false;
+        }
+
+        if (ethertype == 0x0800 && n >= payload + 20) {
+            out.src_hash = hash_bytes(&frame[payload + 12], 4);
+            out.dst_hash = hash_bytes(&frame[payload + 16], 4);
+            out.traffic_class = frame[payload + 1] >> 5; // IP precedence bits
+        } else {
+            out.src_hash = hash_bytes(&frame[src_mac], 6);
+            out.dst_hash = hash_bytes(&frame[dst_mac], 6);
+            out.traffic_class = 0;
+        }
+        return true;
+    }
+
+    std::vector<Record> records;
+};
+
+class TrafficGenerator {
+public:
+    // A generator may own only the inputs [input_begin, input_end), so a
+    // parallel simulator can give each block of ports its own stream.
+    TrafficGenerator(const TrafficConfig& config, int num_ports, uint64_t seed, uint64_t stream,
+                     const PacketTrace* trace = nullptr, int input_begin = 0, int input_end = -1)
+        : config(config), num_ports(num_ports), gen(seed, stream), trace(trace),
+          input_begin(input_begin), input_end(input_end < 0 ? num_ports : input_end),
+          on(num_ports, 0), burst_output(num_ports, 0), burst_class(num_ports, 0) {
+        arrival_threshold = to_threshold(config.load);
+
+        // ON -> OFF after each packet with probability p = 1 / mean_burst;
+        // OFF -> ON with probability q. The OFF -> ON cycle already carries a
+        // packet, so a cycle has one with probability L = q / (p + q - pq);
+        // q = L p / (1 - L + L p) makes that the configured load.
+        double p = config.mean_burst > 1.0 ? 1.0 / config.mean_burst : 1.0;
+        double q = config.load < 1.0 ? config.load * p / (1.0 - config.load + config.load * p) : 1.0;
+        end_burst_threshold = to_threshold(p);
+        start_burst_threshold = to_threshold(q > 1.0 ? 1.0 : q);
+        hotspot_threshold = to_threshold(config.hotspot_fraction);
+        diagonal_threshold = to_threshold(config.diagonal_fraction);
+    }
+
+    // Calls emit(input, output, traffic_class) for every packet arriving in `cycle`.
+    template <typename Emit>
+    void generate(uint64_t cycle, Emit&& emit) {
+        if (config.arrivals == ARRIVAL_TRACE) {
+            replay(cycle, emit);
+            return;
+        }
+        for (int input = input_begin; input < input_end; ++input) {
+            if (config.arrivals == ARRIVAL_BERNOULLI) {
+                if (gen() < arrival_threshold) {
+                    emit(input, pick_output(input), static_cast<int>(gen.bounded(config.num_classes)));
+                }
+                continue;
+            }
+            // On/off: a burst keeps one destination and class for its whole length.
+            if (!on[input]) {
+                if (gen() >= start_burst_threshold) continue;
+                on[input] = 1;
+                burst_output[input] = pick_output(input);
+                burst_class[input] = static_cast<int>(gen.bounded(config.num_classes));
+            }
+            emit(input, burst_output[input], burst_class[input]);
+            if (gen() < end_burst_threshold) on[input] = 0;
+        }
+    }
+
+    // True once a trace replay has emitted every record.
+    bool finished() const {
+        return config.arrivals == ARRIVAL_TRACE && (!trace || cursor >= trace->get_records().size());
+    }
+
+private:
+    static uint64_t to_threshold(double probability) {
+        if (probability >= 1.0) return UINT64_MAX;
+        if (probability <= 0.0) return 0;
+        return static_cast<uint64_t>(probability * 18446744073709551615.0);
+    }
+
+    int pick_output(int input) {
+        uint64_t bits = gen();
+        switch (config.destinations) {
+            case DEST_HOTSPOT:
+                if (bits < hotspot_threshold) return config.hotspot_port;
+                return static_cast<int>(gen.bounded(num_ports));
+            case DEST_DIAGONAL:
+                return bits < diagonal_threshold ? input : (input + 1) % num_ports;
+            default:
+                return static_cast<int>(((bits >> 32) * static_cast<uint64_t>(num_ports)) >> 32);
+        }
+    }
+
+    template <typename Emit>
+    void replay(uint64_t cycle, Emit& emit) {
+        if (!trace) return;
+        const std::vector<PacketTrace::Record>& records = trace->get_records();
+        while (cursor < records.size() && records[cursor].cycle <= cycle) {
+            const PacketTrace::Record& r = records[cursor++];
+            emit(static_cast<int>(r.src_hash % num_ports), static_cast<int>(r.dst_hash % num_ports),
+                 r.traffic_class % config.num_classes);
+        }
+    }
+
+    TrafficConfig config;
+    int num_ports;
+    CounterRng gen;
+    const PacketTrace* trace;
+    int input_begin;
+    int input_end;
+    size_t cursor = 0;
+    uint64_t arrival_threshold;
+    uint64_t start_burst_threshold;
+    uint64_t end_burst_threshold;
+    uint64_t hotspot_threshold;
+    uint64_t diagonal_threshold;
+    std::vector<uint8_t> on;
+    std::vector<int> burst_output;
+    std::vector<int> burst_class;
+};
+
+// Named presets used on the command line. The first three keep the meaning
+// of the Lab 4 traffic types; the rest expose the new destination matrices.
+inline bool parse_traffic(const std::string& name, TrafficConfig& out) {
+    if (name == "uniform") {
+        out.arrivals = ARRIVAL_BERNOULLI;
+        out.destinations = DEST_UNIFORM;
+    } else if (name == "non-uniform" || name == "hotspot") {
+        out.arrivals = ARRIVAL_BERNOULLI;
+        out.destinations = DEST_HOTSPOT;
+    } else if (name == "bursty") {
+        out.arrivals = ARRIVAL_ONOFF;
+        out.destinations = DEST_UNIFORM;
+    } else if (name == "diagonal") {
+        out.arrivals = ARRIVAL_BERNOULLI;
+        out.destinations = DEST_DIAGONAL;
+    } else if (name == "bursty-hotspot") {
+        out.arrivals = ARRIVAL_ONOFF;
+        out.destinations = DEST_HOTSPOT;
+    } else if (name == "bursty-diagonal") {
+        out.arrivals = ARRIVAL_ONOFF;
+        out.destinations = DEST_DIAGONAL;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+#endif
@@ -0,0 +1,105 @@
+#ifndef VOQ_SWITCH_H
+#define VOQ_SWITCH_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "arbiters.h"
+#include "packet_pool.h"
+#include "rng.h"
+#include "sim_stats.h"
+#include "traffic.h"
+
+// Input-queued switch with one virtual output queue per (input, output)
+// pair, so any crossbar arbiter from arbiters.h can be compared on the same
+// fabric and the same arrivals. Matched packets cross the fabric and leave
+// their output in the same cycle.
+
+struct VoqConfig {
+    int num_ports = 32;
+    int voq_limit = 64;         // packets per VOQ
+    int input_buffer = 256;     // packets per input across all of its VOQs
+    ArbiterType arbiter = ARB_ISLIP;
+    int iterations = 1;         // for iSLIP and PIM
+    uint64_t cycles = 100000;
+    uint64_t seed = 1;
+    uint64_t stream = 0;
+    TrafficConfig traffic;
+};
+
+struct VoqPacket {
+    uint32_t arrival_time;
+    uint32_t traffic_class;
+};
+
+class VoqSwitch {
+public:
+    explicit VoqSwitch(const VoqConfig& config)
+        : config(config), n(config.num_ports), stats(config.num_ports, config.traffic.num_classes),
+          traffic(config.traffic, config.num_ports, config.seed, config.stream),
+          arbiter_rng(config.seed, config.stream ^ 0x5a5a5a5a5a5a5a5aULL),
+          pool(static_cast<uint32_t>(config.num_ports) * config.input_buffer),
+          voqs(static_cast<size_t>(config.num_ports) * config.num_ports, RingQueue(config.voq_limit)),
+          input_occupancy(config.num_ports, 0) {
+        requests.reset(n);
+        arbiter = make_arbiter(config.arbiter, n, config.iterations, config.voq_limit);
+    }
+
+    void run() {
+        for (uint64_t cycle = 0; cycle < config.cycles; ++cycle) {
+            step(cycle);
+        }
+        stats.cycles += config.cycles;
+    }
+
+    const SimStats& get_stats() const { return stats; }
+    const char* arbiter_name() const { return arbiter->name(); }
+
+private:
+    void step(uint64_t cycle) {
+        traffic.generate(cycle, [&](int input, int output, int traffic_class) {
+            enqueue(input, output, traffic_class, cycle);
+        });
+
+        arbiter->match(requests, matching, arbiter_rng);
+
+        for (int input = 0; input < n; ++input) {
+            int output = matching[input];
+            if (output < 0) continue;
+            size_t index = static_cast<size_t>(input) * n + output;
+            PacketHandle handle = voqs[index].pop();
+            if (--requests.length[index] == 0) requests.clear(input, output);
+            input_occupancy[input]--;
+            stats.record_departure(output, cycle - pool[handle].arrival_time, pool[handle].traffic_class);
+            pool.release(handle);
+        }
+    }
+
+    void enqueue(int input, int output, int traffic_class, uint64_t cycle) {
+        stats.generated++;
+        size_t index = static_cast<size_t>(input) * n + output;
+        if (input_occupancy[input] >= config.input_buffer || voqs[index].full()) {
+            stats.record_drop(input);
+            return;
+        }
+        PacketHandle handle = pool.allocate();
+        pool[handle] = VoqPacket{static_cast<uint32_t>(cycle), static_cast<uint32_t>(traffic_class)};
+        voqs[index].push(handle);
+        input_occupancy[input]++;
+        if (requests.length[index]++ == 0) requests.set(input, output);
+    }
+
+    VoqConfig config;
+    int n;
+    SimStats stats;
+    TrafficGenerator traffic;
+    CounterRng arbiter_rng; // separate stream so arbiters never perturb arrivals
+    PacketPool<VoqPacket> pool;
+    std::vector<RingQueue> voqs;
+    std::vector<int> input_occupancy;
+    RequestMatrix requests;
+    std::unique_ptr<Arbiter> arbiter;
+    std::vector<int> matching;
+};
+
+#endif
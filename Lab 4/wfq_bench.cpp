@@ -0,0 +1,142 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <iomanip>
+#include <string>
+#include <algorithm>
+#include "wfq_engine.h"
+
+// Fairness/latency benchmark for the WFQ and DRR engines.
+// Usage: ./wfq_bench [flows] [packets] [load]
+// Flows get weights 1..4 and random packet sizes; the offered load is a
+// fraction of the link rate (> 1 keeps every flow backlogged).
+
+constexpr double LINK_RATE = 1250.0; // bytes per microsecond (10 Gb/s)
+constexpr int MAX_WEIGHT = 4;
+
+struct Arrival {
+    double time;
+    uint32_t flow;
+    uint32_t length;
+};
+
+struct BenchResult {
+    double seconds;
+    double jain_index;
+    std::vector<double> avg_delay_by_weight;
+    std::vector<double> max_delay_by_weight;
+};
+
+// Flows are picked in proportion to their weight, so a fair scheduler gives
+// every flow the same weight-normalized share under overload.
+std::vector<Arrival> generate_arrivals(const std::vector<int>& weights, int num_packets, double load, uint32_t seed) {
+    std::mt19937 gen(seed);
+    std::discrete_distribution<int> flow_dist(weights.begin(), weights.end());
+    std::uniform_int_distribution<int> size_dist(64, 1500);
+    double mean_size = (64 + 1500) / 2.0;
+    std::exponential_distribution<double> gap_dist(load * LINK_RATE / mean_size);
+
+    std::vector<Arrival> arrivals(num_packets);
+    double time = 0;
+    for (Arrival& arrival : arrivals) {
+        time += gap_dist(gen);
+        arrival = {time, static_cast<uint32_t>(flow_dist(gen)), static_cast<uint32_t>(size_dist(gen))};
+    }
+    return arrivals;
+}
+
+// Runs the output link: packets arrive over time and the scheduler picks the
+// next one whenever the link becomes free.
+template <typename Scheduler>
+BenchResult run(Scheduler& scheduler, const std::vector<Arrival>& arrivals,
+                const std::vector<int>& weights) {
+    int num_flows = static_cast<int>(weights.size());
+    std::vector<double> served_bytes(num_flows, 0.0);
+    std::vector<double> delay_sum(MAX_WEIGHT + 1, 0.0);
+    std::vector<double> delay_max(MAX_WEIGHT + 1, 0.0);
+    std::vector<long long> delay_count(MAX_WEIGHT + 1, 0);
+
+    auto start = std::chrono::steady_clock::now();
+    double time = 0;
+    size_t next = 0;
+    double last_arrival = arrivals.empty() ? 0 : arrivals.back().time;
+    while (next < arrivals.size() || !scheduler.empty()) {
+        if (scheduler.empty() && time < arrivals[next].time) {
+            time = arrivals[next].time;
+        }
+        while (next < arrivals.size() && arrivals[next].time <= time) {
+            const Arrival& a = arrivals[next];
+            scheduler.enqueue(a.flow, a.length, a.time, static_cast<uint32_t>(next));
+            next++;
+        }
+        WfqPacket packet;
+        if (!scheduler.dequeue(time, packet)) continue;
+        time += packet.length / LINK_RATE;
+
+        // Fairness is measured only while arrivals are still coming in, so the
+        // drain at the end does not hide the share each flow was given.
+        if (time <= last_arrival) {
+            served_bytes[packet.flow] += packet.length;
+        }
+        int w = weights[packet.flow];
+        double delay = time - packet.arrival_time;
+        delay_sum[w] += delay;
+        delay_max[w] = std::max(delay_max[w], delay);
+        delay_count[w]++;
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    // Jain's index over weight-normalized throughput.
+    double sum = 0, sum_sq = 0;
+    for (int f = 0; f < num_flows; ++f) {
+        double x = served_bytes[f] / weights[f];
+        sum += x;
+        sum_sq += x * x;
+    }
+
+    BenchResult result;
+    result.seconds = std::chrono::duration<double>(end - start).count();
+    result.jain_index = sum_sq > 0 ? (sum * sum) / (num_flows * sum_sq) : 1.0;
+    for (int w = 1; w <= MAX_WEIGHT; ++w) {
+        result.avg_delay_by_weight.push_back(delay_count[w] ? delay_sum[w] / delay_count[w] : 0);
+        result.max_delay_by_weight.push_back(delay_max[w]);
+    }
+    return result;
+}
+
+void print_result(const std::string& name, const BenchResult& r, int num_packets) {
+    std::cout << name << ": " << std::fixed << std::setprecision(2)
+              << num_packets / r.seconds / 1e6 << " Mpkt/s, Jain index "
+              << std::setprecision(4) << r.jain_index << "\n";
+    for (int w = 1; w <= MAX_WEIGHT; ++w) {
+        std::cout << "  weight " << w << ": avg delay " << std::setprecision(1)
+                  << r.avg_delay_by_weight[w - 1] << " us, max delay "
+                  << r.max_delay_by_weight[w - 1] << " us\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int num_flows = argc > 1 ? std::stoi(argv[1]) : 4096;
+    int num_packets = argc > 2 ? std::stoi(argv[2]) : 2000000;
+    double load = argc > 3 ? std::stod(argv[3]) : 1.2;
+
+    std::vector<int> weights(num_flows);
+    for (int f = 0; f < num_flows; ++f) {
+        weights[f] = f % MAX_WEIGHT + 1;
+    }
+    std::vector<Arrival> arrivals = generate_arrivals(weights, num_packets, load, 42);
+
+    std::cout << "Flows: " << num_flows << ", packets: " << num_packets
+              << ", offered load: " << load << "\n";
+
+    WfqScheduler wfq(LINK_RATE);
+    for (int f = 0; f < num_flows; ++f) wfq.add_flow(weights[f]);
+    print_result("WFQ (heap)", run(wfq, arrivals, weights), num_packets);
+
+    DrrScheduler drr;
+    for (int f = 0; f < num_flows; ++f) drr.add_flow(1500 * weights[f]);
+    print_result("DRR", run(drr, arrivals, weights), num_packets);
+
+    return 0;
+}
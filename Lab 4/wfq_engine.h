@@ -0,0 +1,203 @@
+#ifndef WFQ_ENGINE_H
+#define WFQ_ENGINE_H
+
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <vector>
+
+// Packet as seen by the fair queueing engines. Lengths are in bytes and
+// times are in whatever unit the caller uses for the link rate.
+struct WfqPacket {
+    uint32_t id;
+    uint32_t flow;
+    uint32_t length;
+    double arrival_time;
+    double finish_tag;
+};
+
+// Weighted fair queueing: emulates the GPS virtual time V(t) and stamps each
+// packet with F = max(V(a), F_prev) + L / w. The packet with the smallest
+// finish tag is sent next; flows are kept in a min-heap keyed by the tag of
+// their head packet, so enqueue/dequeue are O(log n) in the number of flows.
+class WfqScheduler {
+public:
+    explicit WfqScheduler(double link_rate) : link_rate(link_rate) {}
+
+    int add_flow(double weight) {
+        flows.push_back(Flow{weight, 0.0, {}});
+        return static_cast<int>(flows.size()) - 1;
+    }
+
+    void enqueue(uint32_t flow_id, uint32_t length, double now, uint32_t packet_id) {
+        advance_virtual_time(now);
+        Flow& flow = flows[flow_id];
+
+        // A flow whose last tag is behind V is idle in GPS; it rejoins the
+        // backlogged set and contributes its weight again.
+        if (flow.last_finish <= virtual_time) {
+            gps_weight += flow.weight;
+        }
+        double start = flow.last_finish > virtual_time ? flow.last_finish : virtual_time;
+        flow.last_finish = start + length / flow.weight;
+        gps_departures.push({flow.last_finish, flow_id});
+
+        WfqPacket packet{packet_id, flow_id, length, now, flow.last_finish};
+        flow.packets.push(packet);
+        if (flow.packets.size() == 1) {
+            ready.push({packet.finish_tag, flow_id});
+        }
+        backlog_packets++;
+    }
+
+    bool dequeue(double now, WfqPacket& out) {
+        advance_virtual_time(now);
+        if (ready.empty()) return false;
+
+        uint32_t flow_id = ready.top().second;
+        ready.pop();
+        Flow& flow = flows[flow_id];
+        out = flow.packets.front();
+        flow.packets.pop();
+        if (!flow.packets.empty()) {
+            ready.push({flow.packets.front().finish_tag, flow_id});
+        }
+        backlog_packets--;
+        return true;
+    }
+
+    double current_virtual_time(double now) {
+        advance_virtual_time(now);
+        return virtual_time;
+    }
+
+    bool empty() const { return backlog_packets == 0; }
+    size_t backlog() const { return backlog_packets; }
+    size_t num_flows() const { return flows.size(); }
+
+private:
+    struct Flow {
+        double weight;
+        double last_finish;
+        std::queue<WfqPacket> packets;
+    };
+
+    using TagEntry = std::pair<double, uint32_t>; // (finish tag, flow)
+    using MinHeap = std::priority_queue<TagEntry, std::vector<TagEntry>, std::greater<TagEntry>>;
+
+    // Moves V(t) from last_update to now. V grows at link_rate / (sum of GPS
+    // backlogged weights); each time it crosses a flow's last finish tag the
+    // flow leaves the GPS backlog and the slope changes.
+    void advance_virtual_time(double now) {
+        double elapsed = now - last_update;
+        last_update = now;
+        while (elapsed > 0 && gps_weight > 0) {
+            if (gps_departures.empty()) {
+                gps_weight = 0;
+                break;
+            }
+            TagEntry next = gps_departures.top();
+            if (next.first != flows[next.second].last_finish) {
+                gps_departures.pop(); // stale: flow received a later packet
+                continue;
+            }
+            double time_to_next = (next.first - virtual_time) * gps_weight / link_rate;
+            if (time_to_next > elapsed) {
+                virtual_time += elapsed * link_rate / gps_weight;
+                return;
+            }
+            virtual_time = next.first;
+            elapsed -= time_to_next;
+            gps_weight -= flows[next.second].weight;
+            gps_departures.pop();
+        }
+        // Flows whose tag V has just reached (ties) also leave the backlog.
+        while (!gps_departures.empty() && gps_departures.top().first <= virtual_time) {
+            TagEntry next = gps_departures.top();
+            gps_departures.pop();
+            if (next.first == flows[next.second].last_finish) {
+                gps_weight -= flows[next.second].weight;
+            }
+        }
+        if (gps_weight <= 1e-12) {
+            gps_weight = 0; // system idle in GPS: V holds until the next arrival
+        }
+    }
+
+    double link_rate;
+    double virtual_time = 0.0;
+    double last_update = 0.0;
+    double gps_weight = 0.0;
+    size_t backlog_packets = 0;
+    std::vector<Flow> flows;
+    MinHeap ready;          // head packet of each backlogged flow
+    MinHeap gps_departures; // last finish tag of each GPS-backlogged flow
+};
+
+// Deficit round robin: O(1) per packet. Each visit adds the flow's quantum to
+// its deficit counter and sends head packets while they fit.
+class DrrScheduler {
+public:
+    int add_flow(uint32_t quantum) {
+        flows.push_back(Flow{quantum, 0, false, false, {}});
+        return static_cast<int>(flows.size()) - 1;
+    }
+
+    void enqueue(uint32_t flow_id, uint32_t length, double now, uint32_t packet_id) {
+        Flow& flow = flows[flow_id];
+        flow.packets.push(WfqPacket{packet_id, flow_id, length, now, 0.0});
+        if (!flow.active) {
+            flow.active = true;
+            flow.visited = false;
+            active_list.push(flow_id);
+        }
+        backlog_packets++;
+    }
+
+    bool dequeue(double, WfqPacket& out) {
+        while (!active_list.empty()) {
+            uint32_t flow_id = active_list.front();
+            Flow& flow = flows[flow_id];
+            if (!flow.visited) {
+                flow.deficit += flow.quantum;
+                flow.visited = true;
+            }
+            if (flow.packets.front().length <= flow.deficit) {
+                out = flow.packets.front();
+                flow.packets.pop();
+                flow.deficit -= out.length;
+                if (flow.packets.empty()) {
+                    flow.deficit = 0;
+                    flow.active = false;
+                    active_list.pop();
+                }
+                backlog_packets--;
+                return true;
+            }
+            // Head packet does not fit: keep the deficit and go to the back.
+            flow.visited = false;
+            active_list.pop();
+            active_list.push(flow_id);
+        }
+        return false;
+    }
+
+    bool empty() const { return backlog_packets == 0; }
+    size_t backlog() const { return backlog_packets; }
+    size_t num_flows() const { return flows.size(); }
+
+private:
+    struct Flow {
+        uint32_t quantum;
+        uint32_t deficit;
+        bool active;
+        bool visited;
+        std::queue<WfqPacket> packets;
+    };
+
+    size_t backlog_packets = 0;
+    std::vector<Flow> flows;
+    std::queue<uint32_t> active_list;
+};
+
+#endif
@@ -0,0 +1,135 @@
+#include <iostream>
+#include <vector>
+#include <tuple>
+#include <chrono>
+#include <iomanip>
+#include <random>
+#include <algorithm>
+#include <string>
+#include "graph.h"
+#include "dv_engine.h"
+
+using namespace std;
+
+// Distance-vector benchmark.
+//  1. The dense bellman_ford from task1.cpp against the worklist engine on
+//     small graphs (results must agree), with the dense cost extrapolated.
+//  2. The engine on 10k-100k node random graphs for a sample of destinations,
+//     including incremental link failures against recomputing from scratch.
+// Usage: ./dv_bench [largest graph] [sampled destinations] [failures]
+
+// task1.cpp's bellman_ford, unchanged apart from 0-based edges.
+void lab_bellman_ford(int N, vector<vector<int>>& routing_table, vector<tuple<int, int, int>>& edges) {
+    for (int k = 0; k < N - 1; ++k) {
+        for (auto& edge : edges) {
+            int u, v, cost;
+            tie(u, v, cost) = edge;
+            for (int node = 0; node < N; ++node) {
+                if (routing_table[node][u] != INF) {
+                    routing_table[node][v] = min(routing_table[node][v], routing_table[node][u] + cost);
+                }
+                if (routing_table[node][v] != INF) {
+                    routing_table[node][u] = min(routing_table[node][u], routing_table[node][v] + cost);
+                }
+            }
+        }
+    }
+}
+
+double seconds_since(chrono::steady_clock::time_point start) {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+    int largest = argc > 1 ? stoi(argv[1]) : 100000;
+    int sampled = argc > 2 ? stoi(argv[2]) : 32;
+    int failures = argc > 3 ? stoi(argv[3]) : 20;
+
+    cout << "Dense bellman_ford (task1) vs worklist engine, all destinations, ~2.5 links per node\n";
+    cout << "  nodes   links   dense (s)   engine (s)   speedup   same\n";
+    double dense_per_unit = 0; // seconds per N * N * M
+    for (int N : {100, 200, 400}) {
+        Graph graph = make_random_graph(N, N + N / 2, 10, N);
+        vector<tuple<int, int, int>> edges;
+        for (int u = 0; u < N; ++u) {
+            for (const Neighbor& nb : graph.neighbors(u)) {
+                if (u < nb.node) edges.push_back(make_tuple(u, nb.node, nb.cost));
+            }
+        }
+        vector<vector<int>> table(N, vector<int>(N, INF));
+        for (int i = 0; i < N; ++i) table[i][i] = 0;
+        for (auto& e : edges) {
+            table[get<0>(e)][get<1>(e)] = get<2>(e);
+            table[get<1>(e)][get<0>(e)] = get<2>(e);
+        }
+        auto start = chrono::steady_clock::now();
+        lab_bellman_ford(N, table, edges);
+        double dense = seconds_since(start);
+        dense_per_unit = dense / (double(N) * N * edges.size());
+
+        DistanceVectorEngine engine(graph);
+        start = chrono::steady_clock::now();
+        engine.converge();
+        double sparse = seconds_since(start);
+
+        bool same = true;
+        for (int i = 0; i < N && same; ++i) {
+            for (int j = 0; j < N; ++j) {
+                if (table[i][j] != engine.distance(i, j)) {
+                    same = false;
+                    break;
+                }
+            }
+        }
+        cout << setw(7) << N << setw(8) << edges.size() << fixed << setprecision(4) << setw(12) << dense
+             << setw(13) << sparse << setprecision(0) << setw(9) << dense / sparse << "x" << setw(7)
+             << (same ? "yes" : "NO") << "\n";
+    }
+
+    cout << "\nEngine on large graphs, " << sampled << " sampled destinations (full cost extrapolated)\n";
+    cout << "  nodes   per dest (ms)   all dests (s)   dense est. (s)   fail incr. (ms)   fail rebuild (ms)   same\n";
+    for (int N : {10000, 30000, 100000}) {
+        if (N > largest) break;
+        Graph graph = make_random_graph(N, N + N / 2, 10, N);
+        mt19937_64 gen(N);
+        vector<int> destinations;
+        for (int i = 0; i < sampled; ++i) destinations.push_back(static_cast<int>(gen() % N));
+        sort(destinations.begin(), destinations.end());
+        destinations.erase(unique(destinations.begin(), destinations.end()), destinations.end());
+
+        DistanceVectorEngine engine(graph, destinations);
+        auto start = chrono::steady_clock::now();
+        engine.converge();
+        double per_dest = seconds_since(start) / destinations.size();
+
+        // Fail links that carry traffic: the first hop of a random node's route.
+        double incremental = 0;
+        for (int f = 0; f < failures; ++f) {
+            int node = static_cast<int>(gen() % N);
+            int dest = destinations[gen() % destinations.size()];
+            int hop = engine.next_hop(node, dest);
+            if (hop < 0 || hop == node) continue;
+            start = chrono::steady_clock::now();
+            engine.fail_link(node, hop);
+            incremental += seconds_since(start);
+        }
+
+        DistanceVectorEngine rebuilt(engine.get_graph(), destinations);
+        start = chrono::steady_clock::now();
+        rebuilt.converge();
+        double rebuild = seconds_since(start);
+
+        bool same = true;
+        for (int dest : destinations) {
+            for (int v = 0; v < N; ++v) {
+                if (engine.distance(v, dest) != rebuilt.distance(v, dest)) same = false;
+            }
+        }
+        double dense_estimate = dense_per_unit * double(N) * N * graph.num_edges();
+        cout << setw(7) << N << setprecision(3) << setw(16) << per_dest * 1e3 << setprecision(1)
+             << setw(16) << per_dest * N << scientific << setprecision(1) << setw(17) << dense_estimate
+             << fixed << setprecision(3) << setw(18) << incremental * 1e3 / failures
+             << setw(20) << rebuild * 1e3 << setw(7) << (same ? "yes" : "NO") << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,197 @@
+#ifndef DV_ENGINE_H
+#define DV_ENGINE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <utility>
+#include <vector>
+#include "graph.h"
+
+// Worklist-driven distance-vector engine on a sparse graph.
+//
+// Routes to each tracked destination are kept as a distance and next hop per
+// node. Only nodes whose entry changed re-advertise: a popped node offers
+// its distance to each neighbor, and a neighbor that improves is queued in
+// turn. That is distributed Bellman-Ford with the rounds replaced by a
+// queue, O(degree) work per change instead of N - 1 passes over every edge
+// for every node.
+//
+// Topology changes are applied in place. A cheaper or new link is relaxed
+// from both ends. A failed or dearer link invalidates only the nodes whose
+// next-hop chain crosses it (the subtree below it in that destination's
+// tree); those take the best offer from their unaffected neighbors and the
+// worklist repairs the rest. Nothing counts to infinity.
+//
+// Destinations are tracked independently, so a large graph can be run for
+// a sample of destinations with memory N * destinations.
+
+class DistanceVectorEngine {
+public:
+    // Tracks every node as a destination when `destinations` is empty.
+    explicit DistanceVectorEngine(const Graph& graph, std::vector<int> destinations = {})
+        : graph(graph), n(graph.size()), destinations(std::move(destinations)),
+          slot_of(graph.size(), -1), queued(graph.size(), 0), affected_mark(graph.size(), 0) {
+        if (this->destinations.empty()) {
+            for (int v = 0; v < n; ++v) this->destinations.push_back(v);
+        }
+        for (size_t i = 0; i < this->destinations.size(); ++i) slot_of[this->destinations[i]] = static_cast<int>(i);
+        dist.assign(this->destinations.size() * n, INF);
+        next.assign(this->destinations.size() * n, -1);
+    }
+
+    // Computes every tracked route from scratch.
+    void converge() {
+        for (size_t slot = 0; slot < destinations.size(); ++slot) {
+            int* d = &dist[slot * n];
+            int* hop = &next[slot * n];
+            std::fill(d, d + n, INF);
+            std::fill(hop, hop + n, -1);
+            int dest = destinations[slot];
+            d[dest] = 0;
+            hop[dest] = dest;
+            push(dest);
+            run(slot);
+        }
+    }
+
+    // Adds the link u-v or changes its cost.
+    void set_link_cost(int u, int v, int cost) {
+        int old_cost = graph.link_cost(u, v);
+        graph.set_link(u, v, cost);
+        if (cost < old_cost) {
+            improve_link(u, v, cost);
+        } else if (cost > old_cost) {
+            worsen_link(u, v);
+        }
+    }
+
+    void fail_link(int u, int v) {
+        if (graph.remove_link(u, v)) worsen_link(u, v);
+    }
+
+    // INF if `dest` is unreachable or not tracked.
+    int distance(int node, int dest) const {
+        int slot = slot_of[dest];
+        return slot < 0 ? INF : dist[static_cast<size_t>(slot) * n + node];
+    }
+
+    int next_hop(int node, int dest) const {
+        int slot = slot_of[dest];
+        return slot < 0 ? -1 : next[static_cast<size_t>(slot) * n + node];
+    }
+
+    const Graph& get_graph() const { return graph; }
+    const std::vector<int>& get_destinations() const { return destinations; }
+
+    uint64_t advertisements = 0; // nodes popped from the worklist
+    uint64_t updates = 0;        // route entries changed
+
+private:
+    void push(int node) {
+        if (!queued[node]) {
+            queued[node] = 1;
+            worklist.push_back(node);
+        }
+    }
+
+    void run(size_t slot) {
+        int* d = &dist[slot * n];
+        int* hop = &next[slot * n];
+        while (!worklist.empty()) {
+            int v = worklist.front();
+            worklist.pop_front();
+            queued[v] = 0;
+            advertisements++;
+            int offer = d[v];
+            if (offer == INF) continue;
+            for (const Neighbor& nb : graph.neighbors(v)) {
+                int candidate = offer + nb.cost;
+                if (candidate < d[nb.node]) {
+                    d[nb.node] = candidate;
+                    hop[nb.node] = v;
+                    updates++;
+                    push(nb.node);
+                }
+            }
+        }
+    }
+
+    void improve_link(int u, int v, int cost) {
+        for (size_t slot = 0; slot < destinations.size(); ++slot) {
+            int* d = &dist[slot * n];
+            int* hop = &next[slot * n];
+            if (d[v] != INF && d[v] + cost < d[u]) {
+                d[u] = d[v] + cost;
+                hop[u] = v;
+                updates++;
+                push(u);
+            }
+            if (d[u] != INF && d[u] + cost < d[v]) {
+                d[v] = d[u] + cost;
+                hop[v] = u;
+                updates++;
+                push(v);
+            }
+            run(slot);
+        }
+    }
+
+    void worsen_link(int u, int v) {
+        for (size_t slot = 0; slot < destinations.size(); ++slot) {
+            const int* hop = &next[slot * n];
+            if (hop[u] == v) repair(slot, u);
+            else if (hop[v] == u) repair(slot, v);
+        }
+    }
+
+    // Invalidates `root` and everything routed through it, then lets the
+    // invalidated nodes pick up offers from the rest of the graph.
+    void repair(size_t slot, int root) {
+        int* d = &dist[slot * n];
+        int* hop = &next[slot * n];
+
+        affected.clear();
+        affected.push_back(root);
+        affected_mark[root] = 1;
+        for (size_t i = 0; i < affected.size(); ++i) {
+            int parent = affected[i];
+            for (const Neighbor& nb : graph.neighbors(parent)) {
+                if (!affected_mark[nb.node] && hop[nb.node] == parent) {
+                    affected_mark[nb.node] = 1;
+                    affected.push_back(nb.node);
+                }
+            }
+        }
+        for (int x : affected) {
+            d[x] = INF;
+            hop[x] = -1;
+        }
+        for (int x : affected) {
+            for (const Neighbor& nb : graph.neighbors(x)) {
+                if (affected_mark[nb.node] || d[nb.node] == INF) continue;
+                if (d[nb.node] + nb.cost < d[x]) {
+                    d[x] = d[nb.node] + nb.cost;
+                    hop[x] = nb.node;
+                }
+            }
+            updates++;
+            if (d[x] != INF) push(x);
+        }
+        for (int x : affected) affected_mark[x] = 0;
+        run(slot);
+    }
+
+    Graph graph;
+    int n;
+    std::vector<int> destinations;
+    std::vector<int> slot_of;
+    std::vector<int> dist; // [slot * n + node]
+    std::vector<int> next;
+    std::deque<int> worklist;
+    std::vector<uint8_t> queued;
+    std::vector<int> affected;
+    std::vector<uint8_t> affected_mark;
+};
+
+#endif
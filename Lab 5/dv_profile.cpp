@@ -0,0 +1,186 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <iomanip>
+#include <algorithm>
+#include <string>
+#include "graph.h"
+#include "topology_io.h"
+#include "topology_gen.h"
+#include "dv_protocol.h"
+#include "dv_profile.h"
+
+using namespace std;
+
+// Convergence profile of the distance-vector protocol after a link failure
+// (dv_profile.h), per policy: route changes, messages and counting steps
+// per bin, and the routing loops the next-hop tables contain at the end of
+// each bin. Prints a summary per policy and a compact timeline (busy spans
+// merged into at most --rows lines); --timeline writes every recorded bin
+// as CSV.
+//
+// The topology is a random graph, a topology_gen.h generator (--topology,
+// sized by --nodes), or a 1-based edge list / CSR file (--input). The failed
+// link defaults to node 1's first link. Nodes on the command line are 0-based.
+// Usage: ./dv_profile [--nodes 200] [--topology kind] [--input file]
+//                     [--fail u v] [--policy all|plain|split|poison]
+//                     [--bin s] [--rows 12] [--timeline file.csv]
+//                     [--period s] [--timeout s] [--hold-down s]
+//                     [--no-triggered] [--delay s] [--infinity m]
+//                     [--fail-at s] [--horizon s] [--seed n]
+
+// Merges the recorded bins into at most `rows` spans of equal length.
+void print_timeline(const vector<DvProfileBin>& bins, double bin, int rows) {
+    if (bins.empty()) {
+        cout << "    (no route changes)\n";
+        return;
+    }
+    double first = bins.front().start, last = bins.back().start + bin;
+    double span = max(bin, (last - first) / rows);
+    uint64_t peak = 0;
+    vector<DvProfileBin> merged;
+    for (const DvProfileBin& b : bins) {
+        double row_start = first + span * static_cast<int>((b.start - first) / span);
+        if (merged.empty() || merged.back().start != row_start) {
+            merged.push_back(DvProfileBin());
+            merged.back().start = row_start;
+        }
+        DvProfileBin& m = merged.back();
+        m.changes += b.changes;
+        m.messages += b.messages;
+        m.increases += b.increases;
+        m.looping_dests = max(m.looping_dests, b.looping_dests);
+        m.looping_nodes = max(m.looping_nodes, b.looping_nodes);
+        m.longest_loop = max(m.longest_loop, b.longest_loop);
+        peak = max(peak, m.changes);
+    }
+    cout << "    from (s)   to (s)   changes   msgs   worse   loops (dests / longest)\n";
+    for (const DvProfileBin& m : merged) {
+        int bar = static_cast<int>(20 * m.changes / max<uint64_t>(peak, 1));
+        cout << "    " << fixed << setprecision(3) << setw(8) << m.start << setw(9) << m.start + span << setw(10)
+             << m.changes << setw(7) << m.messages << setw(8) << m.increases << setw(9) << m.looping_dests
+             << " / " << setw(3) << m.longest_loop << "   " << string(bar, '#') << "\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int nodes = 200;
+    string topology = "random";
+    string input;
+    int fail_u = -1, fail_v = -1;
+    bool fail_given = false;
+    string policy_name = "all";
+    double bin = 0;
+    int rows = 12;
+    string timeline_path;
+    double fail_at = 300;
+    double horizon = 600;
+    DvProtocolConfig config;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--nodes" && i + 1 < argc) {
+            nodes = stoi(argv[++i]);
+        } else if (arg == "--topology" && i + 1 < argc) {
+            topology = argv[++i];
+        } else if (arg == "--input" && i + 1 < argc) {
+            input = argv[++i];
+        } else if (arg == "--fail" && i + 2 < argc) {
+            fail_u = stoi(argv[++i]);
+            fail_v = stoi(argv[++i]);
+            fail_given = true;
+        } else if (arg == "--policy" && i + 1 < argc) {
+            policy_name = argv[++i];
+        } else if (arg == "--bin" && i + 1 < argc) {
+            bin = stod(argv[++i]);
+        } else if (arg == "--rows" && i + 1 < argc) {
+            rows = max(1, stoi(argv[++i]));
+        } else if (arg == "--timeline" && i + 1 < argc) {
+            timeline_path = argv[++i];
+        } else if (arg == "--period" && i + 1 < argc) {
+            config.period = stod(argv[++i]);
+        } else if (arg == "--timeout" && i + 1 < argc) {
+            config.route_timeout = stod(argv[++i]);
+        } else if (arg == "--hold-down" && i + 1 < argc) {
+            config.hold_down = stod(argv[++i]);
+        } else if (arg == "--no-triggered") {
+            config.triggered = false;
+        } else if (arg == "--delay" && i + 1 < argc) {
+            config.link_delay = stod(argv[++i]);
+        } else if (arg == "--infinity" && i + 1 < argc) {
+            config.infinity = stoi(argv[++i]);
+        } else if (arg == "--fail-at" && i + 1 < argc) {
+            fail_at = stod(argv[++i]);
+        } else if (arg == "--horizon" && i + 1 < argc) {
+            horizon = stod(argv[++i]);
+        } else if (arg == "--seed" && i + 1 < argc) {
+            config.seed = stoull(argv[++i]);
+        } else {
+            cerr << "Unknown argument: " << arg << "\n";
+            return 1;
+        }
+    }
+    if (!config.triggered && config.period <= 0) {
+        cerr << "Need triggered or periodic updates\n";
+        return 1;
+    }
+    if (bin <= 0) bin = config.link_delay;
+
+    Graph graph;
+    if (!load_or_make_topology(input, topology, nodes, config.seed, graph)) return 1;
+    int N = graph.size();
+    if (!choose_failed_link(graph, fail_given, fail_u, fail_v)) return 1;
+
+    vector<string> names;
+    if (policy_name == "all") names = {"plain", "split", "poison"};
+    else names = {policy_name};
+    ofstream timeline;
+    if (!timeline_path.empty()) {
+        timeline.open(timeline_path);
+        timeline << "policy,time,changes,messages,increases,looping_dests,looping_nodes,longest_loop\n";
+    }
+
+    cout << N << " nodes, " << graph.num_edges() << " links, fail " << fail_u << "-" << fail_v << " at t="
+         << fail_at << "s; bin " << bin << "s, period " << config.period << "s, timeout " << config.route_timeout
+         << "s, infinity " << config.infinity << "\n";
+    vector<pair<string, DvProfileSummary>> summaries;
+    for (const string& name : names) {
+        DvPolicy policy;
+        if (!parse_dv_policy(name, policy)) {
+            cerr << "Unknown policy: " << name << "\n";
+            return 1;
+        }
+        DvProtocolSim sim(graph, vector<DvPolicy>(N, policy), config);
+        sim.run_until(fail_at);
+        sim.reset_stats();
+        sim.fail_link(fail_u, fail_v);
+        DvConvergenceProfiler profiler(sim, N, bin);
+        profiler.run(fail_at + horizon);
+
+        cout << "\n  " << dv_policy_name(policy) << "\n";
+        print_timeline(profiler.timeline(), bin, rows);
+        summaries.push_back(make_pair(string(dv_policy_name(policy)), profiler.summary));
+        if (timeline.is_open()) {
+            for (const DvProfileBin& b : profiler.timeline()) {
+                timeline << dv_policy_name(policy) << "," << b.start << "," << b.changes << "," << b.messages << ","
+                         << b.increases << "," << b.looping_dests << "," << b.looping_nodes << "," << b.longest_loop
+                         << "\n";
+            }
+        }
+    }
+
+    cout << "\n  policy            conv (s)   changes     msgs    worse   loops from-to (s)     peak dests  longest"
+            "  exposure (dest*s)\n";
+    for (const pair<string, DvProfileSummary>& entry : summaries) {
+        const DvProfileSummary& s = entry.second;
+        cout << "  " << left << setw(17) << entry.first << right << fixed << setprecision(3) << setw(9)
+             << s.converged << setw(10) << s.changes << setw(9) << s.messages << setw(9) << s.increases;
+        if (s.first_loop < 0) {
+            cout << "   none                       -        -                  -\n";
+        } else {
+            cout << setw(9) << s.first_loop << " - " << left << setw(9) << s.last_loop + bin << right << setw(11)
+                 << s.peak_looping_dests << setw(9) << s.longest_loop << setw(19) << s.loop_exposure << "\n";
+        }
+    }
+    cout << "(worse: changes to a higher finite metric, i.e. counting steps; msgs: sent until the last change)\n";
+    return 0;
+}
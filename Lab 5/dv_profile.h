@@ -0,0 +1,152 @@
+#ifndef DV_PROFILE_H
+#define DV_PROFILE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "dv_protocol.h"
+
+// Convergence profile of a DvProtocolSim run.
+//
+// The run is cut into fixed-length bins (iterations; one link delay is about
+// one hop of propagation). After each bin the profiler records the route
+// changes, messages and counting steps of the bin, and looks for routing
+// loops in the destinations whose routes changed. For one destination the
+// next hops of all nodes form a graph with one out-edge per node, so its
+// loops are that graph's cycles, found in O(N) by walking from every node
+// and stopping at anything already visited. A destination that did not
+// change keeps the loops it had: its next hops have not moved either. That
+// keeps loops visible that no update breaks, such as the ones split horizon
+// leaves in place until their routes time out.
+
+struct LoopCount {
+    int loops = 0; // cycles in the next-hop graph
+    int nodes = 0; // nodes on them
+    int longest = 0;
+};
+
+class RoutingLoopFinder {
+public:
+    explicit RoutingLoopFinder(int n) : mark(n, 0) {}
+
+    // next_hop(v) is v's next hop towards `dest`, or -1 without a route.
+    template <class NextHop>
+    LoopCount find(int dest, NextHop next_hop) {
+        LoopCount count;
+        uint64_t first_walk = walk + 1;
+        for (int v = 0; v < static_cast<int>(mark.size()); ++v) {
+            if (mark[v] >= first_walk) continue;
+            ++walk;
+            int x = v;
+            while (x >= 0 && x != dest && mark[x] < first_walk) {
+                mark[x] = walk;
+                x = next_hop(x);
+            }
+            // Back on this walk's own trail: a new cycle through x.
+            if (x >= 0 && x != dest && mark[x] == walk) {
+                int length = 1;
+                for (int y = next_hop(x); y != x; y = next_hop(y)) length++;
+                count.loops++;
+                count.nodes += length;
+                count.longest = std::max(count.longest, length);
+            }
+        }
+        return count;
+    }
+
+private:
+    std::vector<uint64_t> mark; // walk that last visited each node
+    uint64_t walk = 0;
+};
+
+struct DvProfileBin {
+    double start = 0; // relative to the start of the profile
+    uint64_t changes = 0;
+    uint64_t messages = 0;
+    uint64_t increases = 0;
+    int looping_dests = 0; // at the end of the bin
+    int looping_nodes = 0; // summed over those destinations
+    int longest_loop = 0;
+};
+
+struct DvProfileSummary {
+    double converged = 0; // last route change, relative to the start
+    uint64_t changes = 0;
+    uint64_t messages = 0;
+    uint64_t increases = 0;
+    double first_loop = -1; // start of the first bin ending with a loop
+    double last_loop = -1;
+    int peak_looping_dests = 0;
+    int longest_loop = 0;
+    double loop_exposure = 0; // destination-seconds spent in a loop
+};
+
+class DvConvergenceProfiler {
+public:
+    // Profiles `sim` from its current time; call sim.reset_stats() first.
+    DvConvergenceProfiler(DvProtocolSim& sim, int n, double bin)
+        : sim(sim), bin(bin), start(sim.now()), finder(n), loops(n) {
+        std::vector<int> ignored;
+        sim.take_changed_destinations(ignored);
+        for (int d = 0; d < n; ++d) update(d);
+    }
+
+    // Runs the simulation to `until`, bin by bin. Only bins with route
+    // changes or loops go into the timeline.
+    void run(double until) {
+        std::vector<int> dests;
+        while (sim.now() < until) {
+            double bin_start = sim.now();
+            DvProtocolStats before = sim.stats;
+            sim.run_until(std::min(until, bin_start + bin));
+            sim.take_changed_destinations(dests);
+            for (int d : dests) update(d);
+
+            DvProfileBin row;
+            row.start = bin_start - start;
+            row.changes = sim.stats.route_changes - before.route_changes;
+            row.messages = sim.stats.messages - before.messages;
+            row.increases = sim.stats.metric_increases - before.metric_increases;
+            row.looping_dests = looping_dests;
+            row.looping_nodes = looping_nodes;
+            if (looping_dests > 0) {
+                for (const LoopCount& c : loops) row.longest_loop = std::max(row.longest_loop, c.longest);
+                if (summary.first_loop < 0) summary.first_loop = row.start;
+                summary.last_loop = row.start;
+                summary.peak_looping_dests = std::max(summary.peak_looping_dests, looping_dests);
+                summary.longest_loop = std::max(summary.longest_loop, row.longest_loop);
+                summary.loop_exposure += looping_dests * (sim.now() - bin_start);
+            }
+            if (row.changes > 0 || row.looping_dests > 0) bins.push_back(row);
+        }
+        summary.converged = std::max(0.0, sim.stats.last_change - start);
+        summary.changes = sim.stats.route_changes;
+        summary.messages = sim.stats.messages_to_converge;
+        summary.increases = sim.stats.metric_increases;
+    }
+
+    const std::vector<DvProfileBin>& timeline() const { return bins; }
+
+    DvProfileSummary summary;
+
+private:
+    void update(int d) {
+        LoopCount& c = loops[d];
+        looping_dests -= c.loops > 0;
+        looping_nodes -= c.nodes;
+        c = finder.find(d, [&](int v) { return sim.next_hop(v, d); });
+        looping_dests += c.loops > 0;
+        looping_nodes += c.nodes;
+    }
+
+    DvProtocolSim& sim;
+    double bin;
+    double start;
+    RoutingLoopFinder finder;
+    std::vector<LoopCount> loops; // per destination
+    int looping_dests = 0;
+    int looping_nodes = 0;
+    std::vector<DvProfileBin> bins;
+};
+
+#endif
@@ -0,0 +1,382 @@
+#ifndef DV_PROTOCOL_H
+#define DV_PROTOCOL_H
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include "graph.h"
+
+// Discrete-event simulation of a distance-vector routing protocol.
+//
+// Every router runs its own agent. An agent keeps the last metric each
+// neighbor advertised for every destination and picks the cheapest offer
+// over its live links (distributed Bellman-Ford); it never sees the
+// topology. Vectors travel over the links as messages with a per-link delay
+// plus jitter, in FIFO order per direction, so updates race and routes can
+// loop and count to infinity the way they do in a real network.
+//
+//  - Triggered updates: a changed route is sent (changed entries only) after
+//    a random delay in [0, trigger_delay], which batches nearby changes.
+//  - Periodic updates: the full table every `period` seconds per agent
+//    (period 0 disables them). Offers not refreshed within `route_timeout`
+//    are dropped, which is how routes withheld by split horizon age out.
+//  - Policies, chosen per agent: plain, split horizon (routes are not
+//    advertised to their next hop) and poisoned reverse (advertised to the
+//    next hop as unreachable).
+//  - Hold-down: a route whose metric would rise is withdrawn and held
+//    unreachable for `hold_down` seconds, ignoring every offer meanwhile.
+//
+// Metrics are capped at `infinity` (RIP uses 16; costs here are larger).
+
+enum DvPolicy { DV_PLAIN, DV_SPLIT_HORIZON, DV_POISONED_REVERSE };
+
+inline const char* dv_policy_name(DvPolicy policy) {
+    switch (policy) {
+    case DV_SPLIT_HORIZON: return "split-horizon";
+    case DV_POISONED_REVERSE: return "poisoned-reverse";
+    default: return "plain";
+    }
+}
+
+inline bool parse_dv_policy(const std::string& name, DvPolicy& out) {
+    if (name == "plain") out = DV_PLAIN;
+    else if (name == "split" || name == "split-horizon") out = DV_SPLIT_HORIZON;
+    else if (name == "poison" || name == "poisoned-reverse") out = DV_POISONED_REVERSE;
+    else return false;
+    return true;
+}
+
+struct DvProtocolConfig {
+    double link_delay = 0.01;   // seconds per message per link
+    double delay_jitter = 0.5;  // extra delay, uniform in [0, jitter * link_delay]
+    bool triggered = true;
+    double trigger_delay = 0.05;
+    double period = 30;         // 0 = no periodic updates
+    double route_timeout = 180; // only applies with periodic updates
+    double hold_down = 0;       // 0 = no hold-down
+    int infinity = 1000;
+    uint64_t seed = 1;
+};
+
+// Counted since the last reset_stats().
+struct DvProtocolStats {
+    uint64_t messages = 0;
+    uint64_t entries = 0;       // (destination, metric) pairs carried
+    uint64_t route_changes = 0;
+    uint64_t hold_downs = 0;
+    double last_change = 0;     // time of the last route change
+    uint64_t messages_to_converge = 0; // messages sent up to that change
+    int peak_metric = 0;        // largest finite metric any agent used
+    uint64_t metric_increases = 0; // changes to a worse finite metric (counting steps)
+};
+
+class DvProtocolSim {
+public:
+    DvProtocolSim(const Graph& graph, std::vector<DvPolicy> policies, const DvProtocolConfig& config)
+        : config(config), n(graph.size()), policy(std::move(policies)), gen(config.seed) {
+        policy.resize(n, policy.empty() ? DV_PLAIN : policy.back());
+        // Directed links, grouped by source node.
+        first_link.assign(n + 1, 0);
+        for (int v = 0; v < n; ++v) first_link[v + 1] = first_link[v] + static_cast<int>(graph.neighbors(v).size());
+        int links = first_link[n];
+        neighbor.resize(links);
+        cost.resize(links);
+        delay.resize(links);
+        reverse.resize(links);
+        alive.assign(links, 1);
+        arrival_floor.assign(links, 0);
+        std::uniform_real_distribution<double> jitter(0, config.delay_jitter);
+        for (int v = 0; v < n; ++v) {
+            const std::vector<Neighbor>& list = graph.neighbors(v);
+            for (size_t s = 0; s < list.size(); ++s) {
+                int e = first_link[v] + static_cast<int>(s);
+                neighbor[e] = list[s].node;
+                cost[e] = list[s].cost;
+                delay[e] = config.link_delay * (1 + jitter(gen));
+            }
+        }
+        for (int v = 0; v < n; ++v) {
+            for (int e = first_link[v]; e < first_link[v + 1]; ++e) reverse[e] = find_link(neighbor[e], v);
+        }
+        heard.assign(static_cast<size_t>(links) * n, config.infinity);
+        heard_at.assign(static_cast<size_t>(links) * n, 0);
+        dist.assign(static_cast<size_t>(n) * n, config.infinity);
+        next.assign(static_cast<size_t>(n) * n, -1);
+        hold_until.assign(static_cast<size_t>(n) * n, 0);
+        changed_mark.assign(static_cast<size_t>(n) * n, 0);
+        changed.resize(n);
+        trigger_pending.assign(n, 0);
+        dest_dirty.assign(n, 0);
+
+        // Cold start: each agent knows only itself and announces it.
+        std::uniform_real_distribution<double> phase(0, 1);
+        for (int v = 0; v < n; ++v) {
+            set_route(v, v, 0, v);
+            if (config.triggered) schedule_trigger(v);
+            if (config.period > 0) push_event(config.period * phase(gen), EVENT_PERIODIC, v, 0);
+        }
+    }
+
+    // Processes every event up to and including time `until`. Returns false
+    // if the event queue ran dry first (nothing more will ever happen).
+    bool run_until(double until) {
+        while (!events.empty() && events.top().time <= until) {
+            Event ev = events.top();
+            events.pop();
+            clock = ev.time;
+            switch (ev.type) {
+            case EVENT_DELIVER: deliver(ev.a, ev.b); break;
+            case EVENT_TRIGGER: send_triggered(ev.a); break;
+            case EVENT_PERIODIC: send_periodic(ev.a); break;
+            case EVENT_HOLD_EXPIRE: expire_hold(ev.a, ev.b); break;
+            }
+        }
+        clock = std::max(clock, until);
+        return !events.empty();
+    }
+
+    // Both ends notice at once; messages still on the link are lost.
+    void fail_link(int u, int v) {
+        int e = find_link(u, v);
+        if (e < 0 || !alive[e]) return;
+        alive[e] = alive[reverse[e]] = 0;
+        for (int d = 0; d < n; ++d) {
+            recompute(u, d);
+            recompute(v, d);
+        }
+    }
+
+    void reset_stats() {
+        stats = DvProtocolStats();
+        stats.last_change = clock;
+    }
+
+    // Destinations whose route changed at any node since the last call, for
+    // observers that sample the tables between run_until() calls.
+    void take_changed_destinations(std::vector<int>& out) {
+        out.swap(dirty_dests);
+        dirty_dests.clear();
+        for (int d : out) dest_dirty[d] = 0;
+    }
+
+    // config.infinity if unreachable.
+    int distance(int node, int dest) const { return dist[index(node, dest)]; }
+    int next_hop(int node, int dest) const { return next[index(node, dest)]; }
+    double now() const { return clock; }
+    int infinity() const { return config.infinity; }
+
+    DvProtocolStats stats;
+
+private:
+    enum EventType { EVENT_DELIVER, EVENT_TRIGGER, EVENT_PERIODIC, EVENT_HOLD_EXPIRE };
+
+    struct Event {
+        double time;
+        uint64_t seq; // FIFO among equal times, so runs are reproducible
+        EventType type;
+        int a, b;
+        bool operator>(const Event& other) const {
+            return time != other.time ? time > other.time : seq > other.seq;
+        }
+    };
+
+    struct Message {
+        int link; // directed link it travels on
+        std::vector<std::pair<int, int>> entries;
+    };
+
+    size_t index(int node, int dest) const { return static_cast<size_t>(node) * n + dest; }
+
+    int find_link(int u, int v) const {
+        for (int e = first_link[u]; e < first_link[u + 1]; ++e) {
+            if (neighbor[e] == v) return e;
+        }
+        return -1;
+    }
+
+    void push_event(double time, EventType type, int a, int b) {
+        events.push(Event{time, event_seq++, type, a, b});
+    }
+
+    void schedule_trigger(int v) {
+        if (trigger_pending[v]) return;
+        trigger_pending[v] = 1;
+        std::uniform_real_distribution<double> wait(0, config.trigger_delay);
+        push_event(clock + wait(gen), EVENT_TRIGGER, v, 0);
+    }
+
+    void set_route(int v, int d, int metric, int hop) {
+        size_t i = index(v, d);
+        if (dist[i] == metric && next[i] == hop) return;
+        bool advertised_change = dist[i] != metric;
+        if (metric > dist[i] && metric < config.infinity) stats.metric_increases++;
+        if (!dest_dirty[d]) {
+            dest_dirty[d] = 1;
+            dirty_dests.push_back(d);
+        }
+        dist[i] = metric;
+        next[i] = hop;
+        stats.route_changes++;
+        stats.last_change = clock;
+        stats.messages_to_converge = stats.messages;
+        if (metric < config.infinity) stats.peak_metric = std::max(stats.peak_metric, metric);
+        // A new next hop alone changes what split horizon / poisoned reverse
+        // tell the old and new next hop, so it is advertised too.
+        if ((advertised_change || policy[v] != DV_PLAIN) && !changed_mark[i]) {
+            changed_mark[i] = 1;
+            changed[v].push_back(d);
+        }
+        if (config.triggered) schedule_trigger(v);
+    }
+
+    bool fresh(size_t heard_index) const {
+        return config.period <= 0 || config.route_timeout <= 0 || clock - heard_at[heard_index] <= config.route_timeout;
+    }
+
+    // Best offer over live links, subject to hold-down.
+    void recompute(int v, int d) {
+        if (v == d) return;
+        size_t i = index(v, d);
+        if (hold_until[i] > clock) return;
+        int best = config.infinity;
+        int hop = -1;
+        for (int e = first_link[v]; e < first_link[v + 1]; ++e) {
+            if (!alive[e]) continue;
+            size_t h = static_cast<size_t>(e) * n + d;
+            if (heard[h] >= config.infinity || !fresh(h)) continue;
+            int metric = std::min(config.infinity, cost[e] + heard[h]);
+            // Keep the current next hop on a tie.
+            if (metric < best || (metric == best && neighbor[e] == next[i])) {
+                best = metric;
+                hop = neighbor[e];
+            }
+        }
+        if (best >= config.infinity) hop = -1;
+        if (config.hold_down > 0 && dist[i] < config.infinity && best > dist[i]) {
+            hold_until[i] = clock + config.hold_down;
+            stats.hold_downs++;
+            push_event(hold_until[i], EVENT_HOLD_EXPIRE, v, d);
+            set_route(v, d, config.infinity, -1);
+            return;
+        }
+        set_route(v, d, best, hop);
+    }
+
+    void expire_hold(int v, int d) {
+        if (hold_until[index(v, d)] <= clock) recompute(v, d);
+    }
+
+    // Sends `dests` from v to every live neighbor, applying v's policy.
+    void advertise(int v, const std::vector<int>& dests) {
+        for (int e = first_link[v]; e < first_link[v + 1]; ++e) {
+            if (!alive[e]) continue;
+            int to = neighbor[e];
+            int m;
+            if (free_messages.empty()) {
+                m = static_cast<int>(messages.size());
+                messages.emplace_back();
+            } else {
+                m = free_messages.back();
+                free_messages.pop_back();
+            }
+            Message& msg = messages[m];
+            msg.link = e;
+            msg.entries.clear();
+            for (int d : dests) {
+                size_t i = index(v, d);
+                int metric = dist[i];
+                if (next[i] == to && d != v) {
+                    if (policy[v] == DV_SPLIT_HORIZON) continue;
+                    if (policy[v] == DV_POISONED_REVERSE) metric = config.infinity;
+                }
+                msg.entries.push_back(std::make_pair(d, metric));
+            }
+            if (msg.entries.empty()) {
+                free_messages.push_back(m);
+                continue;
+            }
+            stats.messages++;
+            stats.entries += msg.entries.size();
+            std::uniform_real_distribution<double> jitter(0, config.delay_jitter * config.link_delay);
+            double arrival = std::max(clock + delay[e] + jitter(gen), arrival_floor[e]);
+            arrival_floor[e] = arrival;
+            push_event(arrival, EVENT_DELIVER, m, 0);
+        }
+    }
+
+    void send_triggered(int v) {
+        trigger_pending[v] = 0;
+        if (changed[v].empty()) return;
+        std::vector<int> dests;
+        dests.swap(changed[v]);
+        for (int d : dests) changed_mark[index(v, d)] = 0;
+        advertise(v, dests);
+    }
+
+    void send_periodic(int v) {
+        // Let offers that have aged out go before advertising.
+        for (int d = 0; d < n; ++d) recompute(v, d);
+        if (all_dests.empty()) {
+            for (int d = 0; d < n; ++d) all_dests.push_back(d);
+        }
+        for (int d : changed[v]) changed_mark[index(v, d)] = 0;
+        changed[v].clear();
+        advertise(v, all_dests);
+        push_event(clock + config.period, EVENT_PERIODIC, v, 0);
+    }
+
+    void deliver(int m, int) {
+        int e = messages[m].link;
+        if (alive[e]) {
+            int in = reverse[e];
+            int v = neighbor[e];
+            for (const std::pair<int, int>& entry : messages[m].entries) {
+                size_t h = static_cast<size_t>(in) * n + entry.first;
+                heard[h] = entry.second;
+                heard_at[h] = clock;
+                recompute(v, entry.first);
+            }
+        }
+        free_messages.push_back(m);
+    }
+
+    DvProtocolConfig config;
+    int n;
+    std::vector<DvPolicy> policy;
+    std::mt19937_64 gen;
+    double clock = 0;
+
+    // Directed link e runs from its source to neighbor[e]; reverse[e] is the
+    // opposite direction, i.e. the link on which the neighbor hears us.
+    std::vector<int> first_link;
+    std::vector<int> neighbor;
+    std::vector<int> cost;
+    std::vector<double> delay;
+    std::vector<int> reverse;
+    std::vector<uint8_t> alive;
+    std::vector<double> arrival_floor; // keeps each direction FIFO
+
+    std::vector<int> heard;       // [e * n + dest]: metric the source of e heard from neighbor[e]
+    std::vector<double> heard_at;
+    std::vector<int> dist;        // [node * n + dest]
+    std::vector<int> next;
+    std::vector<double> hold_until;
+    std::vector<uint8_t> changed_mark;
+    std::vector<std::vector<int>> changed; // per node, awaiting a triggered update
+    std::vector<uint8_t> trigger_pending;
+    std::vector<int> all_dests;
+    std::vector<uint8_t> dest_dirty;
+    std::vector<int> dirty_dests;
+
+    std::vector<Message> messages;
+    std::vector<int> free_messages;
+    std::priority_queue<Event, std::vector<Event>, std::greater<Event>> events;
+    uint64_t event_seq = 0;
+};
+
+#endif
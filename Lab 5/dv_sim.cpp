@@ -0,0 +1,146 @@
+#include <iostream>
+#include <vector>
+#include <iomanip>
+#include <random>
+#include <string>
+#include "graph.h"
+#include "topology_io.h"
+#include "topology_gen.h"
+#include "dv_engine.h"
+#include "dv_protocol.h"
+
+using namespace std;
+
+// Runs the distance-vector protocol simulator (dv_protocol.h) once per
+// policy on the same topology: cold start, then one link failure. Reports
+// how long routes took to settle, how many messages that cost, and how high
+// metrics climbed while counting to infinity. Final routes are checked
+// against a centrally computed table.
+//
+// The topology is a random graph, one of the topology_gen.h generators with
+// --topology (--nodes is its size), or with --input a task1-style file (N M,
+// then M lines "u v cost", 1-based) or its binary CSR form (topo_tool).
+// Nodes on the command line are 0-based.
+// Usage: ./dv_sim [--nodes 30] [--links 15] [--topology kind] [--input file]
+//                 [--fail u v] [--policy all|plain|split|poison|mixed] [--hold-down s]
+//                 [--period s] [--timeout s] [--no-triggered] [--delay s]
+//                 [--infinity m] [--fail-at s] [--horizon s] [--seed n]
+
+int main(int argc, char* argv[]) {
+    int nodes = 30;
+    int links = -1;
+    string topology = "random";
+    string input;
+    int fail_u = -1, fail_v = -1;
+    bool fail_given = false;
+    string policy_name = "all";
+    double fail_at = 300;
+    double horizon = 600;
+    DvProtocolConfig config;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--nodes" && i + 1 < argc) {
+            nodes = stoi(argv[++i]);
+        } else if (arg == "--links" && i + 1 < argc) {
+            links = stoi(argv[++i]);
+        } else if (arg == "--topology" && i + 1 < argc) {
+            topology = argv[++i];
+        } else if (arg == "--input" && i + 1 < argc) {
+            input = argv[++i];
+        } else if (arg == "--fail" && i + 2 < argc) {
+            fail_u = stoi(argv[++i]);
+            fail_v = stoi(argv[++i]);
+            fail_given = true;
+        } else if (arg == "--policy" && i + 1 < argc) {
+            policy_name = argv[++i];
+        } else if (arg == "--hold-down" && i + 1 < argc) {
+            config.hold_down = stod(argv[++i]);
+        } else if (arg == "--period" && i + 1 < argc) {
+            config.period = stod(argv[++i]);
+        } else if (arg == "--timeout" && i + 1 < argc) {
+            config.route_timeout = stod(argv[++i]);
+        } else if (arg == "--no-triggered") {
+            config.triggered = false;
+        } else if (arg == "--delay" && i + 1 < argc) {
+            config.link_delay = stod(argv[++i]);
+        } else if (arg == "--infinity" && i + 1 < argc) {
+            config.infinity = stoi(argv[++i]);
+        } else if (arg == "--fail-at" && i + 1 < argc) {
+            fail_at = stod(argv[++i]);
+        } else if (arg == "--horizon" && i + 1 < argc) {
+            horizon = stod(argv[++i]);
+        } else if (arg == "--seed" && i + 1 < argc) {
+            config.seed = stoull(argv[++i]);
+        } else {
+            cerr << "Unknown argument: " << arg << "\n";
+            return 1;
+        }
+    }
+    if (!config.triggered && config.period <= 0) {
+        cerr << "Need triggered or periodic updates\n";
+        return 1;
+    }
+
+    Graph graph;
+    if (!load_or_make_topology(input, topology, nodes, config.seed, graph, links < 0 ? nodes / 2 : links)) return 1;
+    int N = graph.size();
+    if (!choose_failed_link(graph, fail_given, fail_u, fail_v)) return 1;
+
+    // Routes the protocol should settle on.
+    Graph after = graph;
+    after.remove_link(fail_u, fail_v);
+    DistanceVectorEngine reference(after);
+    reference.converge();
+
+    vector<string> rows;
+    if (policy_name == "all") rows = {"plain", "split", "poison", "mixed"};
+    else rows = {policy_name};
+
+    cout << N << " nodes, " << graph.num_edges() << " links, fail " << fail_u << "-" << fail_v << " at t="
+         << fail_at << "s; delay " << config.link_delay << "s, "
+         << (config.triggered ? "triggered" : "no triggered") << " updates, period " << config.period
+         << "s, hold-down " << config.hold_down << "s, infinity " << config.infinity << "\n";
+    cout << "                    cold start                 after failure\n";
+    cout << "  policy            conv (s)   msgs    entries  conv (s)   msgs    entries  changes  holds  peak   routes\n";
+    for (const string& row : rows) {
+        vector<DvPolicy> policies(N);
+        if (row == "mixed") {
+            // Each agent independently picks one of the three policies.
+            mt19937_64 gen(config.seed);
+            for (DvPolicy& p : policies) p = static_cast<DvPolicy>(gen() % 3);
+        } else {
+            DvPolicy p;
+            if (!parse_dv_policy(row, p)) {
+                cerr << "Unknown policy: " << row << "\n";
+                return 1;
+            }
+            policies.assign(N, p);
+        }
+
+        DvProtocolSim sim(graph, policies, config);
+        sim.run_until(fail_at);
+        DvProtocolStats cold = sim.stats;
+        sim.reset_stats();
+        sim.fail_link(fail_u, fail_v);
+        sim.run_until(fail_at + horizon);
+        const DvProtocolStats& failure = sim.stats;
+
+        int wrong = 0;
+        for (int v = 0; v < N; ++v) {
+            for (int d = 0; d < N; ++d) {
+                int expected = reference.distance(v, d);
+                if (expected == INF || expected > sim.infinity()) expected = sim.infinity();
+                if (sim.distance(v, d) != expected) wrong++;
+            }
+        }
+
+        cout << "  " << left << setw(17) << (row == "mixed" ? "mixed" : dv_policy_name(policies[0])) << right
+             << fixed << setprecision(3) << setw(9) << cold.last_change << setw(7) << cold.messages_to_converge
+             << setw(11) << cold.entries << setw(10) << failure.last_change - fail_at << setw(7)
+             << failure.messages_to_converge << setw(11) << failure.entries << setw(9) << failure.route_changes
+             << setw(7) << failure.hold_downs << setw(6) << failure.peak_metric << "   "
+             << (wrong == 0 ? "ok" : to_string(wrong) + " wrong") << "\n";
+    }
+    cout << "(msgs: messages sent until the last route change; entries: all entries sent in the phase)\n";
+    return 0;
+}
@@ -0,0 +1,221 @@
+#ifndef FIB_H
+#define FIB_H
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Forwarding tables over IPv4 prefixes.
+//
+// A router's routes (prefix -> next hop) are first aggregated in a binary
+// trie: two sibling prefixes with the same next hop become their parent, and
+// a prefix whose next hop is the one it would inherit from its nearest
+// covering prefix is dropped. Forwarding is unchanged for every address.
+//
+// Lookups go through a DIR-24-8 table: one 16-bit entry per /24 holds either
+// a next hop or, for /24s that contain longer prefixes, the index of a
+// 256-entry second-level group. Every lookup is one or two memory reads.
+// lookup_batch() splits a batch into the two stages and prefetches each
+// entry before it is needed, so the cache misses of one address overlap with
+// the work on the others.
+
+struct Prefix {
+    uint32_t addr; // host bits zero
+    int len;
+    int next_hop;
+};
+
+inline uint32_t prefix_mask(int len) {
+    return len == 0 ? 0 : ~uint32_t(0) << (32 - len);
+}
+
+inline std::string prefix_string(uint32_t addr, int len) {
+    return std::to_string(addr >> 24) + "." + std::to_string((addr >> 16) & 255) + "." +
+           std::to_string((addr >> 8) & 255) + "." + std::to_string(addr & 255) + "/" + std::to_string(len);
+}
+
+// Binary trie of prefixes; also the reference longest-prefix match.
+class PrefixTrie {
+public:
+    static constexpr int NO_ROUTE = -1;
+
+    PrefixTrie() : nodes(1) {}
+
+    explicit PrefixTrie(const std::vector<Prefix>& prefixes) : nodes(1) {
+        for (const Prefix& p : prefixes) insert(p);
+    }
+
+    void insert(const Prefix& p) {
+        int x = 0;
+        for (int depth = 0; depth < p.len; ++depth) {
+            int bit = (p.addr >> (31 - depth)) & 1;
+            if (nodes[x].child[bit] < 0) {
+                nodes[x].child[bit] = static_cast<int>(nodes.size());
+                nodes.emplace_back();
+            }
+            x = nodes[x].child[bit];
+        }
+        nodes[x].next_hop = p.next_hop;
+    }
+
+    int lookup(uint32_t addr) const {
+        int best = NO_ROUTE;
+        int x = 0;
+        for (int depth = 0; x >= 0; ++depth) {
+            if (nodes[x].next_hop != NO_ROUTE) best = nodes[x].next_hop;
+            if (depth == 32) break;
+            x = nodes[x].child[(addr >> (31 - depth)) & 1];
+        }
+        return best;
+    }
+
+    // Merges siblings with equal next hops and drops redundant prefixes.
+    void aggregate() {
+        merge(0);
+        prune(0, NO_ROUTE);
+    }
+
+    std::vector<Prefix> prefixes() const {
+        std::vector<Prefix> out;
+        collect(0, 0, 0, out);
+        return out;
+    }
+
+private:
+    struct Node {
+        int child[2] = {-1, -1};
+        int next_hop = NO_ROUTE;
+    };
+
+    void merge(int x) {
+        Node& node = nodes[x];
+        int c0 = node.child[0], c1 = node.child[1];
+        if (c0 >= 0) merge(c0);
+        if (c1 >= 0) merge(c1);
+        if (c0 < 0 || c1 < 0) return;
+        int hop = nodes[c0].next_hop;
+        if (hop == NO_ROUTE || hop != nodes[c1].next_hop) return;
+        // The two halves cover all of this prefix, so its own route (if
+        // any) was never used.
+        nodes[x].next_hop = hop;
+        nodes[c0].next_hop = NO_ROUTE;
+        nodes[c1].next_hop = NO_ROUTE;
+    }
+
+    void prune(int x, int inherited) {
+        Node& node = nodes[x];
+        if (node.next_hop != NO_ROUTE) {
+            if (node.next_hop == inherited) node.next_hop = NO_ROUTE;
+            else inherited = node.next_hop;
+        }
+        if (node.child[0] >= 0) prune(node.child[0], inherited);
+        if (node.child[1] >= 0) prune(nodes[x].child[1], inherited);
+    }
+
+    void collect(int x, uint32_t addr, int len, std::vector<Prefix>& out) const {
+        const Node& node = nodes[x];
+        if (node.next_hop != NO_ROUTE) out.push_back(Prefix{addr, len, node.next_hop});
+        if (node.child[0] >= 0) collect(node.child[0], addr, len + 1, out);
+        if (node.child[1] >= 0) collect(node.child[1], addr | (uint32_t(1) << (31 - len)), len + 1, out);
+    }
+
+    std::vector<Node> nodes;
+};
+
+// Aggregated copy of `routes`.
+inline std::vector<Prefix> aggregate_prefixes(const std::vector<Prefix>& routes) {
+    PrefixTrie trie(routes);
+    trie.aggregate();
+    return trie.prefixes();
+}
+
+class Dir24_8 {
+public:
+    static constexpr int NO_ROUTE = -1;
+    static constexpr int MAX_NEXT_HOP = 0x7FFE;
+    static constexpr size_t MAX_GROUPS = 0x8000; // 15-bit tbl8 group index
+
+    // Next hops must be in [0, MAX_NEXT_HOP], and prefixes longer than /24
+    // may fall in at most MAX_GROUPS distinct /24s; the 16-bit entries have
+    // no room for more. A table that breaks either limit is not built and
+    // ok() is false.
+    explicit Dir24_8(std::vector<Prefix> prefixes) : tbl24(1u << 24, EMPTY) {
+        // Shorter prefixes first, so longer ones overwrite them; every
+        // prefix of /24 or shorter is in place before any group is split off.
+        std::sort(prefixes.begin(), prefixes.end(),
+                  [](const Prefix& a, const Prefix& b) { return a.len < b.len; });
+        for (const Prefix& p : prefixes) {
+            if (p.next_hop < 0 || p.next_hop > MAX_NEXT_HOP) {
+                fail();
+                return;
+            }
+            uint16_t hop = static_cast<uint16_t>(p.next_hop);
+            if (p.len <= 24) {
+                uint32_t first = p.addr >> 8;
+                std::fill(&tbl24[first], &tbl24[first] + (size_t(1) << (24 - p.len)), hop);
+                continue;
+            }
+            uint16_t& entry = tbl24[p.addr >> 8];
+            if (!(entry & EXTENDED)) {
+                if (groups() == MAX_GROUPS) {
+                    fail();
+                    return;
+                }
+                uint16_t group = static_cast<uint16_t>(tbl8.size() / 256);
+                tbl8.resize(tbl8.size() + 256, entry);
+                entry = EXTENDED | group;
+            }
+            uint32_t first = (entry & ~EXTENDED) * 256u + (p.addr & 255);
+            std::fill(&tbl8[first], &tbl8[first] + (size_t(1) << (32 - p.len)), hop);
+        }
+    }
+
+    bool ok() const { return valid; }
+
+    int lookup(uint32_t addr) const {
+        uint16_t entry = tbl24[addr >> 8];
+        if (entry & EXTENDED) entry = tbl8[(entry & ~EXTENDED) * 256u + (addr & 255)];
+        return entry == EMPTY ? NO_ROUTE : entry;
+    }
+
+    // out[i] = lookup(addrs[i]).
+    void lookup_batch(const uint32_t* addrs, int* out, size_t count) const {
+        const size_t BATCH = 16;
+        uint16_t entry[BATCH];
+        for (size_t base = 0; base < count; base += BATCH) {
+            size_t size = std::min(BATCH, count - base);
+            const uint32_t* a = addrs + base;
+            for (size_t i = 0; i < size; ++i) __builtin_prefetch(&tbl24[a[i] >> 8]);
+            for (size_t i = 0; i < size; ++i) {
+                entry[i] = tbl24[a[i] >> 8];
+                if (entry[i] & EXTENDED) __builtin_prefetch(&tbl8[(entry[i] & ~EXTENDED) * 256u + (a[i] & 255)]);
+            }
+            for (size_t i = 0; i < size; ++i) {
+                uint16_t e = entry[i];
+                if (e & EXTENDED) e = tbl8[(e & ~EXTENDED) * 256u + (a[i] & 255)];
+                out[base + i] = e == EMPTY ? NO_ROUTE : e;
+            }
+        }
+    }
+
+    size_t groups() const { return tbl8.size() / 256; }
+    size_t memory_bytes() const { return (tbl24.size() + tbl8.size()) * sizeof(uint16_t); }
+
+private:
+    static constexpr uint16_t EXTENDED = 0x8000;
+    static constexpr uint16_t EMPTY = 0x7FFF;
+
+    // Every lookup misses in a table that could not be built.
+    void fail() {
+        valid = false;
+        std::fill(tbl24.begin(), tbl24.end(), EMPTY);
+        tbl8.clear();
+    }
+
+    std::vector<uint16_t> tbl24;
+    std::vector<uint16_t> tbl8;
+    bool valid = true;
+};
+
+#endif
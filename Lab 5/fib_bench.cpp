@@ -0,0 +1,155 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <iomanip>
+#include <random>
+#include <algorithm>
+#include <set>
+#include <string>
+#include "graph.h"
+#include "parallel_routes.h"
+#include "fib.h"
+
+using namespace std;
+
+// Forwarding tables from computed routes, and their lookup speed (fib.h).
+//
+// Address plan: node v owns a /20, and 64 consecutive nodes share one /14
+// region placed at random in the IPv4 space (so neighbouring node ids can
+// aggregate, while lookups still spread over the whole 32 MB level-1 table).
+// Each /20 is split into LAN subnets of /21 to /28, about 15% left unused.
+// A router's routes send every subnet of node d to its first hop towards d.
+//
+//  1. For a sample of routers: routes before and after aggregation, and a
+//     check that the aggregated DIR-24-8 table forwards every sampled
+//     address exactly like the raw routes.
+//  2. Lookups per second on one router's table: the binary trie, DIR-24-8
+//     one address at a time, and DIR-24-8 batched with prefetching.
+// Usage: ./fib_bench [nodes <= 4096] [routers] [million lookups] [router to print]
+
+double seconds_since(chrono::steady_clock::time_point start) {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+// Splits addr/len into subnets of /21 to /28 owned by `owner`.
+void allocate_subnets(uint32_t addr, int len, int owner, mt19937_64& gen, vector<Prefix>& out) {
+    if (len >= 28 || (len > 20 && gen() % 3 == 0)) {
+        if (gen() % 100 < 85) out.push_back(Prefix{addr, len, owner});
+        return;
+    }
+    allocate_subnets(addr, len + 1, owner, gen, out);
+    allocate_subnets(addr | (uint32_t(1) << (31 - len)), len + 1, owner, gen, out);
+}
+
+int main(int argc, char* argv[]) {
+    int N = argc > 1 ? stoi(argv[1]) : 4096;
+    int routers = argc > 2 ? stoi(argv[2]) : 16;
+    double millions = argc > 3 ? stod(argv[3]) : 20;
+    int print_router = argc > 4 ? stoi(argv[4]) : -1;
+    if (N < 2 || N > 4096) {
+        cerr << "nodes must be in [2, 4096]\n";
+        return 1;
+    }
+
+    Graph graph = make_random_graph(N, N / 2, 10, N);
+    mt19937_64 gen(1);
+
+    // Address plan.
+    vector<uint32_t> region_base;
+    set<uint32_t> used;
+    while (static_cast<int>(region_base.size()) * 64 < N) {
+        uint32_t base = static_cast<uint32_t>(gen()) & prefix_mask(14);
+        if (used.insert(base).second) region_base.push_back(base);
+    }
+    vector<Prefix> subnets; // next_hop holds the owning node
+    vector<uint32_t> blocks(N);
+    for (int v = 0; v < N; ++v) {
+        blocks[v] = region_base[v / 64] | (uint32_t(v % 64) << 12);
+        allocate_subnets(blocks[v], 20, v, gen, subnets);
+    }
+
+    // Addresses to look up: mostly inside some node's block, some anywhere.
+    size_t count = static_cast<size_t>(millions * 1e6);
+    vector<uint32_t> addrs(count);
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t r = gen();
+        addrs[i] = r % 10 == 0 ? static_cast<uint32_t>(r >> 32)
+                               : blocks[(r >> 8) % N] | static_cast<uint32_t>((r >> 32) & 0xFFF);
+    }
+
+    SpfScratch scratch;
+    auto routes_of = [&](int router) {
+        shortest_paths(graph, router, scratch);
+        vector<Prefix> routes;
+        for (const Prefix& s : subnets) {
+            int hop = scratch.first_hop[s.next_hop];
+            if (hop >= 0) routes.push_back(Prefix{s.addr, s.len, hop});
+        }
+        return routes;
+    };
+
+    cout << N << " nodes, " << graph.num_edges() << " links, " << subnets.size() << " subnets\n\n";
+    cout << "  router   routes   aggregated   ratio   tbl8 groups   table (MB)   same\n";
+    size_t check = min<size_t>(count, 200000);
+    vector<int> out(check);
+    for (int k = 0; k < routers && k < N; ++k) {
+        int router = static_cast<int>(static_cast<int64_t>(k) * N / routers);
+        vector<Prefix> routes = routes_of(router);
+        vector<Prefix> fib = aggregate_prefixes(routes);
+        Dir24_8 table(fib);
+        if (!table.ok()) {
+            cerr << "Router " << router << ": next hops or /24 groups exceed what DIR-24-8 can hold\n";
+            return 1;
+        }
+        PrefixTrie raw(routes);
+        table.lookup_batch(addrs.data(), out.data(), check);
+        bool same = true;
+        for (size_t i = 0; i < check; ++i) {
+            int expected = raw.lookup(addrs[i]);
+            if (table.lookup(addrs[i]) != expected || out[i] != expected) same = false;
+        }
+        cout << setw(8) << router << setw(9) << routes.size() << setw(13) << fib.size() << fixed << setprecision(2)
+             << setw(8) << double(routes.size()) / fib.size() << setw(14) << table.groups() << setprecision(1)
+             << setw(13) << table.memory_bytes() / 1e6 << setw(7) << (same ? "yes" : "NO") << "\n";
+    }
+
+    if (print_router >= 0 && print_router < N) {
+        cout << "\nForwarding table of router " << print_router << " (prefix -> next hop):\n";
+        for (const Prefix& p : aggregate_prefixes(routes_of(print_router))) {
+            cout << "  " << prefix_string(p.addr, p.len) << " -> " << p.next_hop << "\n";
+        }
+    }
+
+    vector<Prefix> routes = routes_of(0);
+    vector<Prefix> fib = aggregate_prefixes(routes);
+    PrefixTrie trie(fib);
+    Dir24_8 table(fib);
+    if (!table.ok()) {
+        cerr << "Router 0: next hops or /24 groups exceed what DIR-24-8 can hold\n";
+        return 1;
+    }
+    out.assign(count, 0);
+    cout << "\nLookups on router 0's table, " << count << " addresses\n";
+    cout << "  method                      Mlookups/s\n";
+    uint64_t checksum = 0;
+
+    size_t trie_count = count / 10;
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < trie_count; ++i) checksum += trie.lookup(addrs[i]);
+    double trie_time = seconds_since(start);
+
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < count; ++i) checksum += table.lookup(addrs[i]);
+    double single_time = seconds_since(start);
+
+    start = chrono::steady_clock::now();
+    table.lookup_batch(addrs.data(), out.data(), count);
+    double batch_time = seconds_since(start);
+    for (size_t i = 0; i < count; ++i) checksum += out[i];
+
+    cout << fixed << setprecision(1) << "  binary trie                 " << setw(10) << trie_count / trie_time / 1e6
+         << "\n  DIR-24-8, one at a time     " << setw(10) << count / single_time / 1e6
+         << "\n  DIR-24-8, batched           " << setw(10) << count / batch_time / 1e6 << "\n";
+    cout << "(checksum " << checksum << ")\n";
+    return 0;
+}
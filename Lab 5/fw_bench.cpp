@@ -0,0 +1,157 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <iomanip>
+#include <string>
+#include "graph.h"
+#include "route_matrix.h"
+
+using namespace std;
+
+// All-pairs routing table benchmark on random graphs (~2.5 links per node).
+//  relax-until-stable: task2's original update loop with INT_MAX guards,
+//                      on a plain vector<vector<int>> (small sizes only)
+//  scalar FW:          textbook k/i/j Floyd-Warshall on the flat matrix
+//  blocked FW:         floyd_warshall() from route_matrix.h
+// Distances of all three must agree. Also checks the tables after a link
+// failure (rebuild_without_link) on a small case where routes cross the link. Build with -mavx2 (or -march=native)
+// for the vectorized kernel; without it the scalar fallback is timed.
+// Usage: ./fw_bench [largest graph] [block]
+
+double seconds_since(chrono::steady_clock::time_point start) {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+RouteMatrix make_routes(const Graph& graph) {
+    RouteMatrix routes(graph.size());
+    for (int u = 0; u < graph.size(); ++u) {
+        for (const Neighbor& nb : graph.neighbors(u)) routes.set_link(u, nb.node, nb.cost);
+    }
+    return routes;
+}
+
+// The pre-matrix task2 update loop, with the guard fixed so that unknown
+// routes can be learned (the lab version also required d[i][k] != INF).
+void relax_until_stable(vector<vector<int>>& d, int n) {
+    bool updated;
+    do {
+        updated = false;
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < n; j++) {
+                if (i == j || d[i][j] == INF) continue;
+                for (int k = 0; k < n; k++) {
+                    if (d[j][k] != INF && d[i][j] + d[j][k] < d[i][k]) {
+                        d[i][k] = d[i][j] + d[j][k];
+                        updated = true;
+                    }
+                }
+            }
+        }
+    } while (updated);
+}
+
+void scalar_floyd_warshall(RouteMatrix& m) {
+    int n = m.size();
+    for (int k = 0; k < n; ++k) {
+        const int32_t* dk = m.dist_row(k);
+        for (int i = 0; i < n; ++i) {
+            int32_t* di = m.dist_row(i);
+            int32_t* ni = m.next_row(i);
+            if (di[k] >= DIST_INF) continue;
+            for (int j = 0; j < n; ++j) {
+                if (di[k] + dk[j] < di[j]) {
+                    di[j] = di[k] + dk[j];
+                    ni[j] = ni[k];
+                }
+            }
+        }
+    }
+}
+
+// 0-1 (1), 1-2 (2), 2-3 (1), 0-3 (5), then 1-2 fails: 1 -> 2 must go
+// 1-0-3-2 (7) and 0 -> 3 direct (5), not the pre-failure 0-1-2-3 (4).
+bool check_link_failure() {
+    vector<RouteLink> links = {{0, 1, 1}, {1, 2, 2}, {2, 3, 1}, {0, 3, 5}};
+    RouteMatrix routes(4);
+    for (const RouteLink& l : links) routes.set_link(l.u, l.v, l.cost);
+    floyd_warshall(routes);
+    if (routes.distance(0, 3) != 4 || routes.next_hop(0, 3) != 1) return false;
+    rebuild_without_link(routes, links, 1, 2);
+    floyd_warshall(routes);
+    return routes.distance(1, 2) == 7 && routes.next_hop(1, 2) == 0 && routes.distance(0, 3) == 5 &&
+           routes.next_hop(0, 3) == 3 && routes.distance(0, 2) == 6 && routes.next_hop(0, 2) == 3 &&
+           routes.distance(2, 1) == 7 && routes.next_hop(2, 1) == 3;
+}
+
+int main(int argc, char* argv[]) {
+    int largest = argc > 1 ? stoi(argv[1]) : 4000;
+    int block = argc > 2 ? stoi(argv[2]) : 64;
+    if (block <= 0 || block % 16 != 0) {
+        cerr << "block must be a positive multiple of 16\n";
+        return 1;
+    }
+#ifdef __AVX2__
+    cout << "Kernel: AVX2, block " << block << "\n";
+#else
+    cout << "Kernel: scalar (build with -mavx2 for AVX2), block " << block << "\n";
+#endif
+    cout << "Link failure check (4 nodes, routes across the link): " << (check_link_failure() ? "yes" : "NO") << "\n";
+    cout << "  nodes   relax loop (s)   scalar FW (s)   blocked FW (s)   speedup   Grelax/s   same\n";
+    for (int n : {100, 250, 500, 1000, 2000, 4000, 8000}) {
+        if (n > largest) break;
+        Graph graph = make_random_graph(n, n + n / 2, 10, n);
+        double cube = double(n) * n * n;
+
+        double loop_time = -1;
+        vector<vector<int>> table;
+        if (n <= 500) {
+            table.assign(n, vector<int>(n, INF));
+            for (int u = 0; u < n; ++u) {
+                table[u][u] = 0;
+                for (const Neighbor& nb : graph.neighbors(u)) table[u][nb.node] = nb.cost;
+            }
+            auto start = chrono::steady_clock::now();
+            relax_until_stable(table, n);
+            loop_time = seconds_since(start);
+        }
+
+        RouteMatrix scalar = make_routes(graph);
+        auto start = chrono::steady_clock::now();
+        scalar_floyd_warshall(scalar);
+        double scalar_time = seconds_since(start);
+
+        RouteMatrix blocked = make_routes(graph);
+        start = chrono::steady_clock::now();
+        floyd_warshall(blocked, block);
+        double blocked_time = seconds_since(start);
+
+        bool same = true;
+        for (int i = 0; i < n && same; ++i) {
+            for (int j = 0; j < n; ++j) {
+                int d = blocked.distance(i, j);
+                if (d != scalar.distance(i, j) || (!table.empty() && table[i][j] != d)) {
+                    same = false;
+                    break;
+                }
+            }
+        }
+        // Next hops may differ on ties but must lead somewhere just as short.
+        for (int i = 0; i < n && same; ++i) {
+            for (int j = 0; j < n; ++j) {
+                int hop = blocked.next_hop(i, j);
+                if (i != j && blocked.distance(i, hop) + blocked.distance(hop, j) != blocked.distance(i, j)) {
+                    same = false;
+                    break;
+                }
+            }
+        }
+
+        cout << setw(7) << n << fixed << setprecision(4);
+        if (loop_time < 0) cout << setw(17) << "-";
+        else cout << setw(17) << loop_time;
+        cout << setw(16) << scalar_time << setw(17) << blocked_time << setprecision(1) << setw(9)
+             << scalar_time / blocked_time << "x" << setprecision(2) << setw(11) << cube / blocked_time / 1e9
+             << setw(7) << (same ? "yes" : "NO") << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,110 @@
+#ifndef GRAPH_H
+#define GRAPH_H
+
+#include <climits>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// Undirected weighted graph stored as adjacency lists, 0-based. The lab
+// programs read 1-based node ids (task1, task3) and convert on input.
+
+const int INF = INT_MAX;
+
+struct Neighbor {
+    int node;
+    int cost;
+};
+
+class Graph {
+public:
+    explicit Graph(int num_nodes = 0) : adjacency(num_nodes) {}
+
+    int size() const { return static_cast<int>(adjacency.size()); }
+    size_t num_edges() const { return edge_count; }
+
+    const std::vector<Neighbor>& neighbors(int node) const { return adjacency[node]; }
+
+    // Adds the link, or changes its cost if it already exists.
+    void set_link(int u, int v, int cost) {
+        if (update(u, v, cost)) {
+            update(v, u, cost);
+            return;
+        }
+        adjacency[u].push_back(Neighbor{v, cost});
+        adjacency[v].push_back(Neighbor{u, cost});
+        edge_count++;
+    }
+
+    // Adds the link without looking for an existing one; for loaders and
+    // generators that know every link is new.
+    void add_link(int u, int v, int cost) {
+        adjacency[u].push_back(Neighbor{v, cost});
+        adjacency[v].push_back(Neighbor{u, cost});
+        edge_count++;
+    }
+
+    void reserve(int node, size_t degree) { adjacency[node].reserve(degree); }
+
+    // Returns false if there was no such link.
+    bool remove_link(int u, int v) {
+        if (!erase(u, v)) return false;
+        erase(v, u);
+        edge_count--;
+        return true;
+    }
+
+    // Cost of the link u-v, or INF.
+    int link_cost(int u, int v) const {
+        for (const Neighbor& n : adjacency[u]) {
+            if (n.node == v) return n.cost;
+        }
+        return INF;
+    }
+
+private:
+    bool update(int u, int v, int cost) {
+        for (Neighbor& n : adjacency[u]) {
+            if (n.node == v) {
+                n.cost = cost;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool erase(int u, int v) {
+        std::vector<Neighbor>& list = adjacency[u];
+        for (size_t i = 0; i < list.size(); ++i) {
+            if (list[i].node == v) {
+                list[i] = list.back();
+                list.pop_back();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::vector<std::vector<Neighbor>> adjacency;
+    size_t edge_count = 0;
+};
+
+// Connected random graph: a random spanning tree plus `extra_links` random
+// links, costs uniform in [1, max_cost].
+inline Graph make_random_graph(int num_nodes, size_t extra_links, int max_cost, uint64_t seed) {
+    std::mt19937_64 gen(seed);
+    std::uniform_int_distribution<int> cost(1, max_cost);
+    Graph g(num_nodes);
+    for (int v = 1; v < num_nodes; ++v) {
+        std::uniform_int_distribution<int> parent(0, v - 1);
+        g.set_link(v, parent(gen), cost(gen));
+    }
+    std::uniform_int_distribution<int> node(0, num_nodes - 1);
+    for (size_t i = 0; i < extra_links; ++i) {
+        int u = node(gen), v = node(gen);
+        if (u != v) g.set_link(u, v, cost(gen));
+    }
+    return g;
+}
+
+#endif
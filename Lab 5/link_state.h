@@ -0,0 +1,273 @@
+#ifndef LINK_STATE_H
+#define LINK_STATE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "graph.h"
+#include "radix_heap.h"
+
+// Link-state routing: a link-state database plus shortest-path trees.
+//
+// The database holds one LSA per router (its sequence number and the links
+// it reports). A link is part of the topology only while both ends report
+// it, as OSPF's two-way check requires. Every router computes a shortest-path
+// tree from itself over that topology with Dijkstra on a radix heap.
+//
+// When a link fails or gets dearer, only the routers whose tree uses it are
+// touched, and in each of those only the subtree below the link is
+// recomputed: the subtree is cut off, each cut node takes its best offer from
+// the rest of the tree, and Dijkstra runs over the cut nodes alone. A cheaper
+// or new link runs Dijkstra from its two ends, which stops wherever nothing
+// improves.
+
+struct Lsa {
+    uint32_t seq = 0;
+    std::vector<Neighbor> links;
+};
+
+class LinkStateDatabase {
+public:
+    // One LSA per router describing its links in `graph`.
+    explicit LinkStateDatabase(const Graph& graph) : lsas(graph.size()), graph(graph) {
+        for (int r = 0; r < graph.size(); ++r) {
+            lsas[r].seq = 1;
+            lsas[r].links = graph.neighbors(r);
+        }
+        originated = graph.size();
+    }
+
+    // Installs an LSA if it is newer than the one held. Links it no longer
+    // reports leave the topology; links it adds join once the other end
+    // reports them too.
+    bool install(int router, const Lsa& lsa) {
+        if (lsa.seq <= lsas[router].seq) return false;
+        for (const Neighbor& old : lsas[router].links) {
+            if (!reports(lsa, old.node)) graph.remove_link(router, old.node);
+        }
+        lsas[router] = lsa;
+        for (const Neighbor& nb : lsa.links) {
+            if (reports(lsas[nb.node], router)) graph.set_link(router, nb.node, nb.cost);
+        }
+        return true;
+    }
+
+    // Both ends re-originate their LSA with the link's new cost.
+    void set_link(int u, int v, int cost) {
+        originate(u, v, cost);
+        originate(v, u, cost);
+    }
+
+    // Both ends re-originate their LSA without the link.
+    bool remove_link(int u, int v) {
+        if (graph.link_cost(u, v) == INF) return false;
+        originate(u, v, INF);
+        originate(v, u, INF);
+        return true;
+    }
+
+    const Lsa& lsa(int router) const { return lsas[router]; }
+    const Graph& topology() const { return graph; }
+
+    // Each LSA is flooded over every link once in each direction at most.
+    uint64_t originated = 0;
+    uint64_t flood_messages = 0;
+
+private:
+    static bool reports(const Lsa& lsa, int node) {
+        for (const Neighbor& nb : lsa.links) {
+            if (nb.node == node) return true;
+        }
+        return false;
+    }
+
+    // New LSA for `router` with the link to `other` at `cost` (INF removes it).
+    void originate(int router, int other, int cost) {
+        Lsa next;
+        next.seq = lsas[router].seq + 1;
+        for (const Neighbor& nb : lsas[router].links) {
+            if (nb.node != other) next.links.push_back(nb);
+        }
+        if (cost != INF) next.links.push_back(Neighbor{other, cost});
+        install(router, next);
+        originated++;
+        flood_messages += 2 * graph.num_edges();
+    }
+
+    std::vector<Lsa> lsas;
+    Graph graph;
+};
+
+class LinkStateEngine {
+public:
+    // Computes trees for every router when `sources` is empty.
+    explicit LinkStateEngine(const Graph& graph, std::vector<int> sources = {})
+        : lsdb(graph), n(graph.size()), sources(std::move(sources)), slot_of(graph.size(), -1),
+          affected_mark(graph.size(), 0) {
+        if (this->sources.empty()) {
+            for (int v = 0; v < n; ++v) this->sources.push_back(v);
+        }
+        for (size_t i = 0; i < this->sources.size(); ++i) slot_of[this->sources[i]] = static_cast<int>(i);
+        dist.assign(this->sources.size() * n, INF);
+        parent.assign(this->sources.size() * n, -1);
+        first_hop.assign(this->sources.size() * n, -1);
+    }
+
+    // Full SPF from every tracked source.
+    void converge() {
+        for (size_t slot = 0; slot < sources.size(); ++slot) {
+            int* d = &dist[slot * n];
+            std::fill(d, d + n, INF);
+            std::fill(&parent[slot * n], &parent[slot * n] + n, -1);
+            std::fill(&first_hop[slot * n], &first_hop[slot * n] + n, -1);
+            int source = sources[slot];
+            d[source] = 0;
+            parent[slot * n + source] = source;
+            heap.clear();
+            heap.push(0, source);
+            run(slot);
+            spf_runs++;
+        }
+    }
+
+    // Adds the link u-v or changes its cost.
+    void set_link_cost(int u, int v, int cost) {
+        int old_cost = lsdb.topology().link_cost(u, v);
+        lsdb.set_link(u, v, cost);
+        if (cost < old_cost) {
+            improve_link(u, v, cost);
+        } else if (cost > old_cost) {
+            worsen_link(u, v);
+        }
+    }
+
+    void fail_link(int u, int v) {
+        if (lsdb.remove_link(u, v)) worsen_link(u, v);
+    }
+
+    // INF if unreachable or `source` is not tracked.
+    int distance(int source, int dest) const {
+        int slot = slot_of[source];
+        return slot < 0 ? INF : dist[static_cast<size_t>(slot) * n + dest];
+    }
+
+    // First hop on the path from `source` (itself for the source).
+    int next_hop(int source, int dest) const {
+        int slot = slot_of[source];
+        if (slot < 0) return -1;
+        return dest == source ? source : first_hop[static_cast<size_t>(slot) * n + dest];
+    }
+
+    const LinkStateDatabase& database() const { return lsdb; }
+    const std::vector<int>& get_sources() const { return sources; }
+
+    uint64_t spf_runs = 0;       // full or partial SPF computations
+    uint64_t nodes_settled = 0;  // nodes popped with a final distance
+
+private:
+    // Dijkstra from whatever is on the heap; only improves entries.
+    void run(size_t slot) {
+        const Graph& graph = lsdb.topology();
+        int* d = &dist[slot * n];
+        int* par = &parent[slot * n];
+        int* hop = &first_hop[slot * n];
+        int source = sources[slot];
+        while (!heap.empty()) {
+            std::pair<uint32_t, int> top = heap.pop();
+            int x = top.second;
+            if (static_cast<int>(top.first) != d[x]) continue;
+            nodes_settled++;
+            if (x != source) hop[x] = par[x] == source ? x : hop[par[x]];
+            for (const Neighbor& nb : graph.neighbors(x)) {
+                int candidate = d[x] + nb.cost;
+                if (candidate < d[nb.node]) {
+                    d[nb.node] = candidate;
+                    par[nb.node] = x;
+                    heap.push(static_cast<uint32_t>(candidate), nb.node);
+                }
+            }
+        }
+    }
+
+    void improve_link(int u, int v, int cost) {
+        for (size_t slot = 0; slot < sources.size(); ++slot) {
+            int* d = &dist[slot * n];
+            int* par = &parent[slot * n];
+            heap.clear();
+            if (d[u] != INF && d[u] + cost < d[v]) {
+                d[v] = d[u] + cost;
+                par[v] = u;
+                heap.push(static_cast<uint32_t>(d[v]), v);
+            } else if (d[v] != INF && d[v] + cost < d[u]) {
+                d[u] = d[v] + cost;
+                par[u] = v;
+                heap.push(static_cast<uint32_t>(d[u]), u);
+            }
+            if (heap.empty()) continue;
+            run(slot);
+            spf_runs++;
+        }
+    }
+
+    void worsen_link(int u, int v) {
+        for (size_t slot = 0; slot < sources.size(); ++slot) {
+            const int* par = &parent[slot * n];
+            if (par[v] == u && v != sources[slot]) repair(slot, v);
+            else if (par[u] == v && u != sources[slot]) repair(slot, u);
+        }
+    }
+
+    // Cuts off the subtree below `root` and re-attaches it.
+    void repair(size_t slot, int root) {
+        const Graph& graph = lsdb.topology();
+        int* d = &dist[slot * n];
+        int* par = &parent[slot * n];
+        int* hop = &first_hop[slot * n];
+
+        affected.clear();
+        affected.push_back(root);
+        affected_mark[root] = 1;
+        for (size_t i = 0; i < affected.size(); ++i) {
+            int p = affected[i];
+            for (const Neighbor& nb : graph.neighbors(p)) {
+                if (!affected_mark[nb.node] && par[nb.node] == p) {
+                    affected_mark[nb.node] = 1;
+                    affected.push_back(nb.node);
+                }
+            }
+        }
+        for (int x : affected) {
+            d[x] = INF;
+            par[x] = -1;
+            hop[x] = -1;
+        }
+        heap.clear();
+        for (int x : affected) {
+            for (const Neighbor& nb : graph.neighbors(x)) {
+                if (affected_mark[nb.node] || d[nb.node] == INF) continue;
+                if (d[nb.node] + nb.cost < d[x]) {
+                    d[x] = d[nb.node] + nb.cost;
+                    par[x] = nb.node;
+                }
+            }
+            if (d[x] != INF) heap.push(static_cast<uint32_t>(d[x]), x);
+        }
+        for (int x : affected) affected_mark[x] = 0;
+        run(slot);
+        spf_runs++;
+    }
+
+    LinkStateDatabase lsdb;
+    int n;
+    std::vector<int> sources;
+    std::vector<int> slot_of;
+    std::vector<int> dist;      // [slot * n + node]
+    std::vector<int> parent;    // tree parent; the source is its own
+    std::vector<int> first_hop;
+    RadixHeap heap;
+    std::vector<int> affected;
+    std::vector<uint8_t> affected_mark;
+};
+
+#endif
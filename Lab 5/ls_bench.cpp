@@ -0,0 +1,122 @@
+#include <iostream>
+#include <vector>
+#include <queue>
+#include <chrono>
+#include <iomanip>
+#include <random>
+#include <algorithm>
+#include <functional>
+#include <string>
+#include "graph.h"
+#include "dv_engine.h"
+#include "link_state.h"
+
+using namespace std;
+
+// Link-state engine against the distance-vector engine on the same random
+// graphs (~2.5 links per node), for a sample of routers.
+//  - full computation per router: Dijkstra on std::priority_queue, the
+//    link-state engine (radix heap) and the DV worklist engine
+//  - a series of link failures on in-use links, applied incrementally by
+//    both engines, against a full SPF rerun on the final topology
+// Both engines must agree, with each other and with the rerun.
+// Usage: ./ls_bench [largest graph] [sampled routers] [failures]
+
+double seconds_since(chrono::steady_clock::time_point start) {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+// Plain binary-heap Dijkstra, as a baseline for the radix heap.
+void binary_heap_dijkstra(const Graph& graph, int source, vector<int>& d) {
+    typedef pair<int, int> Entry;
+    priority_queue<Entry, vector<Entry>, greater<Entry>> heap;
+    fill(d.begin(), d.end(), INF);
+    d[source] = 0;
+    heap.push(Entry(0, source));
+    while (!heap.empty()) {
+        Entry top = heap.top();
+        heap.pop();
+        if (top.first != d[top.second]) continue;
+        for (const Neighbor& nb : graph.neighbors(top.second)) {
+            int candidate = top.first + nb.cost;
+            if (candidate < d[nb.node]) {
+                d[nb.node] = candidate;
+                heap.push(Entry(candidate, nb.node));
+            }
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int largest = argc > 1 ? stoi(argv[1]) : 100000;
+    int sampled = argc > 2 ? stoi(argv[2]) : 32;
+    int failures = argc > 3 ? stoi(argv[3]) : 20;
+
+    cout << "Per router (ms): full computation. Per failure (ms): incremental update, all sampled routers.\n";
+    cout << "  nodes   binary heap   LS radix   DV engine   LS fail   DV fail   LS rerun   settled/fail   same\n";
+    for (int N : {10000, 30000, 100000}) {
+        if (N > largest) break;
+        Graph graph = make_random_graph(N, N + N / 2, 10, N);
+        mt19937_64 gen(N);
+        vector<int> routers;
+        for (int i = 0; i < sampled; ++i) routers.push_back(static_cast<int>(gen() % N));
+        sort(routers.begin(), routers.end());
+        routers.erase(unique(routers.begin(), routers.end()), routers.end());
+        double count = routers.size();
+
+        vector<int> scratch(N);
+        auto start = chrono::steady_clock::now();
+        for (int r : routers) binary_heap_dijkstra(graph, r, scratch);
+        double binary = seconds_since(start) / count;
+
+        LinkStateEngine ls(graph, routers);
+        start = chrono::steady_clock::now();
+        ls.converge();
+        double radix = seconds_since(start) / count;
+
+        DistanceVectorEngine dv(graph, routers);
+        start = chrono::steady_clock::now();
+        dv.converge();
+        double vector_time = seconds_since(start) / count;
+
+        // Fail links that carry traffic: the first hop of a random node's route.
+        double ls_fail = 0, dv_fail = 0;
+        int applied = 0;
+        uint64_t settled_before = ls.nodes_settled;
+        for (int f = 0; f < failures; ++f) {
+            int node = static_cast<int>(gen() % N);
+            int router = routers[gen() % routers.size()];
+            int hop = dv.next_hop(node, router);
+            if (hop < 0 || hop == node) continue;
+            start = chrono::steady_clock::now();
+            ls.fail_link(node, hop);
+            ls_fail += seconds_since(start);
+            start = chrono::steady_clock::now();
+            dv.fail_link(node, hop);
+            dv_fail += seconds_since(start);
+            applied++;
+        }
+        double settled = applied ? double(ls.nodes_settled - settled_before) / applied : 0;
+
+        LinkStateEngine rerun(ls.database().topology(), routers);
+        start = chrono::steady_clock::now();
+        rerun.converge();
+        double full = seconds_since(start);
+
+        bool same = true;
+        for (int r : routers) {
+            for (int v = 0; v < N; ++v) {
+                int d = ls.distance(r, v);
+                if (d != rerun.distance(r, v) || d != dv.distance(v, r)) same = false;
+                // The first hop must be a live link out of the router.
+                if (d != INF && v != r && ls.database().topology().link_cost(r, ls.next_hop(r, v)) == INF) same = false;
+            }
+        }
+        applied = max(applied, 1);
+        cout << setw(7) << N << fixed << setprecision(3) << setw(14) << binary * 1e3 << setw(11) << radix * 1e3
+             << setw(12) << vector_time * 1e3 << setw(10) << ls_fail * 1e3 / applied << setw(10)
+             << dv_fail * 1e3 / applied << setw(11) << full * 1e3 << setprecision(0) << setw(15) << settled
+             << setw(7) << (same ? "yes" : "NO") << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,320 @@
+#ifndef MULTIPATH_H
+#define MULTIPATH_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "graph.h"
+#include "parallel_routes.h"
+#include "radix_heap.h"
+
+// Multipath routing: equal-cost next-hop sets, k shortest paths, and the
+// link loads a traffic matrix puts on the network under each.
+//
+// shortest_paths() (parallel_routes.h) keeps one first hop per destination:
+// a path that only ties the best one is dropped, just as task3's
+// bellman_ford only replaces a route on a strictly lower cost. ecmp_paths()
+// keeps every tying first hop instead, as a bitset over the source's
+// neighbor list.
+
+// ECMP routes from one source. The next-hop set towards `dest` is `words`
+// 64-bit words at hops[dest * words]; bit i stands for the i-th entry of
+// graph.neighbors(source), so a source with up to 64 links needs 8 bytes per
+// destination.
+struct EcmpScratch {
+    std::vector<int> dist; // INF if unreachable
+    std::vector<uint64_t> hops;
+    int words = 0;
+    RadixHeap heap;
+
+    const uint64_t* hop_set(int dest) const { return &hops[static_cast<size_t>(dest) * words]; }
+
+    int hop_count(int dest) const {
+        int count = 0;
+        for (int w = 0; w < words; ++w) count += __builtin_popcountll(hop_set(dest)[w]);
+        return count;
+    }
+};
+
+// Dijkstra that merges first-hop sets on ties. Costs must be positive: then
+// every node on a shortest path to x is settled before x, so x's set is
+// complete when x is popped and passed on.
+inline void ecmp_paths(const Graph& graph, int source, EcmpScratch& s) {
+    int n = graph.size();
+    const std::vector<Neighbor>& links = graph.neighbors(source);
+    int words = std::max<int>(1, (static_cast<int>(links.size()) + 63) / 64);
+    s.words = words;
+    s.dist.assign(n, INF);
+    s.hops.assign(static_cast<size_t>(n) * words, 0);
+    s.dist[source] = 0;
+    s.heap.clear();
+    for (size_t i = 0; i < links.size(); ++i) {
+        int v = links[i].node;
+        uint64_t* set = &s.hops[static_cast<size_t>(v) * words];
+        if (links[i].cost < s.dist[v]) {
+            s.dist[v] = links[i].cost;
+            std::fill(set, set + words, 0);
+        }
+        if (links[i].cost == s.dist[v]) {
+            set[i / 64] |= uint64_t(1) << (i % 64);
+            s.heap.push(static_cast<uint32_t>(links[i].cost), v);
+        }
+    }
+    while (!s.heap.empty()) {
+        std::pair<uint32_t, int> top = s.heap.pop();
+        int x = top.second;
+        if (static_cast<int>(top.first) != s.dist[x]) continue;
+        const uint64_t* from = &s.hops[static_cast<size_t>(x) * words];
+        for (const Neighbor& nb : graph.neighbors(x)) {
+            if (nb.node == source) continue;
+            int candidate = s.dist[x] + nb.cost;
+            uint64_t* to = &s.hops[static_cast<size_t>(nb.node) * words];
+            if (candidate < s.dist[nb.node]) {
+                s.dist[nb.node] = candidate;
+                std::copy(from, from + words, to);
+                s.heap.push(static_cast<uint32_t>(candidate), nb.node);
+            } else if (candidate == s.dist[nb.node]) {
+                for (int w = 0; w < words; ++w) to[w] |= from[w];
+            }
+        }
+    }
+}
+
+// Calls visit(neighbor) for every next hop from `source` towards `dest`.
+template <class Visit>
+void for_each_ecmp_hop(const Graph& graph, int source, const EcmpScratch& s, int dest, Visit visit) {
+    const uint64_t* set = s.hop_set(dest);
+    for (int w = 0; w < s.words; ++w) {
+        for (uint64_t bits = set[w]; bits; bits &= bits - 1) {
+            visit(graph.neighbors(source)[w * 64 + __builtin_ctzll(bits)].node);
+        }
+    }
+}
+
+struct WeightedPath {
+    int cost = 0;
+    std::vector<int> nodes; // source first
+};
+
+// Yen's algorithm: up to `k` loopless paths from s to t in order of cost.
+// Each further path deviates from an earlier one at some spur node; the spur
+// search is a Dijkstra that avoids the root path's nodes and the links the
+// earlier paths with the same root leave the spur node by. Scratch is kept
+// between calls.
+class KShortestPaths {
+public:
+    explicit KShortestPaths(const Graph& graph)
+        : graph(graph), dist(graph.size(), INF), parent(graph.size(), -1), banned(graph.size(), 0) {}
+
+    std::vector<WeightedPath> find(int s, int t, int k) {
+        std::vector<WeightedPath> found;
+        std::vector<WeightedPath> candidates;
+        WeightedPath first;
+        if (k <= 0 || !search(s, t, first)) return found;
+        found.push_back(first);
+        while (static_cast<int>(found.size()) < k) {
+            const WeightedPath& last = found.back();
+            int root_cost = 0;
+            for (size_t i = 0; i + 1 < last.nodes.size(); ++i) {
+                int spur = last.nodes[i];
+                // Links out of the spur node already taken after this root.
+                spur_banned.clear();
+                for (const WeightedPath& p : found) {
+                    if (p.nodes.size() > i + 1 && std::equal(last.nodes.begin(), last.nodes.begin() + i + 1, p.nodes.begin())) {
+                        spur_banned.push_back(p.nodes[i + 1]);
+                    }
+                }
+                for (size_t j = 0; j < i; ++j) banned[last.nodes[j]] = 1;
+                WeightedPath spur_path;
+                if (search(spur, t, spur_path)) {
+                    WeightedPath total;
+                    total.cost = root_cost + spur_path.cost;
+                    total.nodes.assign(last.nodes.begin(), last.nodes.begin() + i);
+                    total.nodes.insert(total.nodes.end(), spur_path.nodes.begin(), spur_path.nodes.end());
+                    if (!contains(candidates, total)) candidates.push_back(total);
+                }
+                for (size_t j = 0; j < i; ++j) banned[last.nodes[j]] = 0;
+                spur_banned.clear();
+                root_cost += graph.link_cost(spur, last.nodes[i + 1]);
+            }
+            if (candidates.empty()) break;
+            // Cheapest candidate, fewest hops on ties.
+            size_t best = 0;
+            for (size_t c = 1; c < candidates.size(); ++c) {
+                if (candidates[c].cost < candidates[best].cost ||
+                    (candidates[c].cost == candidates[best].cost &&
+                     candidates[c].nodes.size() < candidates[best].nodes.size())) {
+                    best = c;
+                }
+            }
+            found.push_back(candidates[best]);
+            candidates[best] = candidates.back();
+            candidates.pop_back();
+        }
+        return found;
+    }
+
+private:
+    static bool contains(const std::vector<WeightedPath>& paths, const WeightedPath& p) {
+        for (const WeightedPath& q : paths) {
+            if (q.cost == p.cost && q.nodes == p.nodes) return true;
+        }
+        return false;
+    }
+
+    // Dijkstra from s to t around the banned nodes and spur links.
+    bool search(int s, int t, WeightedPath& out) {
+        for (int v : touched) {
+            dist[v] = INF;
+            parent[v] = -1;
+        }
+        touched.clear();
+        heap.clear();
+        dist[s] = 0;
+        touched.push_back(s);
+        heap.push(0, s);
+        while (!heap.empty()) {
+            std::pair<uint32_t, int> top = heap.pop();
+            int x = top.second;
+            if (static_cast<int>(top.first) != dist[x]) continue;
+            if (x == t) break;
+            for (const Neighbor& nb : graph.neighbors(x)) {
+                if (banned[nb.node]) continue;
+                if (x == s && std::find(spur_banned.begin(), spur_banned.end(), nb.node) != spur_banned.end()) continue;
+                int candidate = dist[x] + nb.cost;
+                if (candidate < dist[nb.node]) {
+                    if (dist[nb.node] == INF) touched.push_back(nb.node);
+                    dist[nb.node] = candidate;
+                    parent[nb.node] = x;
+                    heap.push(static_cast<uint32_t>(candidate), nb.node);
+                }
+            }
+        }
+        if (dist[t] == INF) return false;
+        out.cost = dist[t];
+        out.nodes.clear();
+        for (int v = t; v != s; v = parent[v]) out.nodes.push_back(v);
+        out.nodes.push_back(s);
+        std::reverse(out.nodes.begin(), out.nodes.end());
+        return true;
+    }
+
+    const Graph& graph;
+    std::vector<int> dist;
+    std::vector<int> parent;
+    std::vector<char> banned;
+    std::vector<int> spur_banned;
+    std::vector<int> touched;
+    RadixHeap heap;
+};
+
+struct Demand {
+    int src;
+    int dst;
+    double volume;
+};
+
+// Traffic carried by each link direction: load(u, i) is the traffic u sends
+// over its i-th link.
+class LinkLoads {
+public:
+    explicit LinkLoads(const Graph& graph) : graph(graph), first(graph.size() + 1, 0) {
+        for (int u = 0; u < graph.size(); ++u) first[u + 1] = first[u] + graph.neighbors(u).size();
+        loads.assign(first.back(), 0);
+    }
+
+    void add(int u, int v, double amount) {
+        const std::vector<Neighbor>& links = graph.neighbors(u);
+        for (size_t i = 0; i < links.size(); ++i) {
+            if (links[i].node == v) {
+                loads[first[u] + i] += amount;
+                return;
+            }
+        }
+    }
+
+    void add_path(const std::vector<int>& nodes, double amount) {
+        for (size_t i = 0; i + 1 < nodes.size(); ++i) add(nodes[i], nodes[i + 1], amount);
+    }
+
+    double max_load() const { return loads.empty() ? 0 : *std::max_element(loads.begin(), loads.end()); }
+
+    double total() const {
+        double sum = 0;
+        for (double load : loads) sum += load;
+        return sum;
+    }
+
+    size_t used_links() const {
+        size_t used = 0;
+        for (double load : loads) used += load > 0;
+        return used;
+    }
+
+private:
+    const Graph& graph;
+    std::vector<size_t> first;
+    std::vector<double> loads;
+};
+
+// Each demand on its single shortest path (the first-hop tie-break of
+// shortest_paths).
+inline void route_single_path(const Graph& graph, std::vector<Demand> demands, LinkLoads& loads) {
+    std::sort(demands.begin(), demands.end(), [](const Demand& a, const Demand& b) { return a.src < b.src; });
+    SpfScratch scratch;
+    std::vector<int> path;
+    for (size_t i = 0; i < demands.size(); ++i) {
+        if (i == 0 || demands[i].src != demands[i - 1].src) shortest_paths(graph, demands[i].src, scratch);
+        if (scratch.dist[demands[i].dst] == INF) continue;
+        for (int v = demands[i].dst; v != demands[i].src; v = scratch.parent[v]) loads.add(scratch.parent[v], v, demands[i].volume);
+    }
+}
+
+// ECMP forwarding: at every node, traffic for a destination is split evenly
+// over all of that node's equal-cost next hops. Per destination, nodes are
+// visited from the farthest in, so each passes on everything it receives.
+inline void route_ecmp(const Graph& graph, std::vector<Demand> demands, LinkLoads& loads) {
+    std::sort(demands.begin(), demands.end(), [](const Demand& a, const Demand& b) { return a.dst < b.dst; });
+    int n = graph.size();
+    SpfScratch scratch;
+    std::vector<double> inflow(n, 0);
+    std::vector<int> order;
+    std::vector<int> next;
+    for (size_t i = 0; i < demands.size();) {
+        int dst = demands[i].dst;
+        shortest_paths(graph, dst, scratch);
+        const std::vector<int>& d = scratch.dist;
+        for (; i < demands.size() && demands[i].dst == dst; ++i) {
+            if (d[demands[i].src] != INF) inflow[demands[i].src] += demands[i].volume;
+        }
+        order.clear();
+        for (int v = 0; v < n; ++v) {
+            if (d[v] != INF) order.push_back(v);
+        }
+        std::sort(order.begin(), order.end(), [&](int a, int b) { return d[a] > d[b]; });
+        for (int x : order) {
+            if (x == dst || inflow[x] == 0) continue;
+            next.clear();
+            for (const Neighbor& nb : graph.neighbors(x)) {
+                if (d[nb.node] != INF && d[nb.node] + nb.cost == d[x]) next.push_back(nb.node);
+            }
+            double share = inflow[x] / next.size();
+            for (int y : next) {
+                loads.add(x, y, share);
+                inflow[y] += share;
+            }
+        }
+        std::fill(inflow.begin(), inflow.end(), 0);
+    }
+}
+
+// Each demand split evenly over its (up to) k shortest loopless paths.
+inline void route_k_shortest(const Graph& graph, const std::vector<Demand>& demands, int k, LinkLoads& loads) {
+    KShortestPaths finder(graph);
+    for (const Demand& demand : demands) {
+        std::vector<WeightedPath> paths = finder.find(demand.src, demand.dst, k);
+        for (const WeightedPath& p : paths) loads.add_path(p.nodes, demand.volume / paths.size());
+    }
+}
+
+#endif
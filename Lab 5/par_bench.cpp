@@ -0,0 +1,98 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <iomanip>
+#include <random>
+#include <algorithm>
+#include <string>
+#include <thread>
+#include "graph.h"
+#include "route_matrix.h"
+#include "parallel_routes.h"
+
+using namespace std;
+
+// Scaling of the parallel all-pairs route computation (parallel_routes.h).
+//  1. Check: full tables on a 1000-node graph against floyd_warshall.
+//  2. 10^4 - 10^5 node graphs (~2.5 links per node), 1 thread up to the
+//     maximum in powers of two. Each source's table is reduced to a
+//     checksum so the run does not need N^2 memory; the checksum must not
+//     depend on the thread count. By default a fixed sample of sources is
+//     used (the full cost is extrapolated); 0 runs every source.
+// Usage: ./par_bench [largest graph] [max threads] [sources per graph]
+
+double seconds_since(chrono::steady_clock::time_point start) {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+    int largest = argc > 1 ? stoi(argv[1]) : 100000;
+    int max_threads = argc > 2 ? stoi(argv[2]) : static_cast<int>(thread::hardware_concurrency());
+    int sampled = argc > 3 ? stoi(argv[3]) : 2000;
+    max_threads = max(max_threads, 1);
+
+    {
+        Graph graph = make_random_graph(1000, 1500, 10, 7);
+        WorkStealingPool pool(max_threads);
+        RouteMatrix parallel;
+        all_pairs_routes(graph, parallel, pool);
+        RouteMatrix reference(1000);
+        for (int u = 0; u < 1000; ++u) {
+            for (const Neighbor& nb : graph.neighbors(u)) reference.set_link(u, nb.node, nb.cost);
+        }
+        floyd_warshall(reference);
+        bool same = true;
+        for (int i = 0; i < 1000; ++i) {
+            for (int j = 0; j < 1000; ++j) {
+                if (parallel.distance(i, j) != reference.distance(i, j)) same = false;
+            }
+        }
+        cout << "1000-node all-pairs tables, " << max_threads << " threads, match floyd_warshall: "
+             << (same ? "yes" : "NO") << "\n\n";
+    }
+
+    cout << "  nodes   sources   threads   time (s)   speedup   efficiency   all sources (s)   steals   same\n";
+    for (int N : {10000, 30000, 100000}) {
+        if (N > largest) break;
+        Graph graph = make_random_graph(N, N + N / 2, 10, N);
+        vector<int> sources;
+        if (sampled <= 0 || sampled >= N) {
+            for (int v = 0; v < N; ++v) sources.push_back(v);
+        } else {
+            mt19937_64 gen(N);
+            for (int i = 0; i < sampled; ++i) sources.push_back(static_cast<int>(gen() % N));
+        }
+
+        double base = 0;
+        uint64_t base_checksum = 0;
+        for (int threads = 1;; threads *= 2) {
+            threads = min(threads, max_threads);
+            WorkStealingPool pool(threads);
+            // Per-worker partial sums, padded apart; combined by addition so
+            // the order sources finish in does not matter.
+            vector<uint64_t> partial(threads * 8, 0);
+            auto start = chrono::steady_clock::now();
+            for_each_source(graph, sources, pool, [&](int worker, int source, const SpfScratch& s) {
+                uint64_t sum = 0;
+                for (int v = 0; v < N; ++v) {
+                    if (s.dist[v] != INF) sum += static_cast<uint64_t>(s.dist[v]) * (v + 1) + s.first_hop[v];
+                }
+                partial[worker * 8] += sum * (static_cast<uint64_t>(source) + 1);
+            });
+            double elapsed = seconds_since(start);
+            uint64_t checksum = 0;
+            for (int w = 0; w < threads; ++w) checksum += partial[w * 8];
+            if (threads == 1) {
+                base = elapsed;
+                base_checksum = checksum;
+            }
+            double speedup = base / elapsed;
+            cout << setw(7) << N << setw(10) << sources.size() << setw(10) << threads << fixed << setprecision(3)
+                 << setw(11) << elapsed << setprecision(2) << setw(10) << speedup << setw(13) << speedup / threads
+                 << setprecision(1) << setw(18) << elapsed * N / sources.size() << setw(9) << pool.steals.load()
+                 << setw(7) << (checksum == base_checksum ? "yes" : "NO") << "\n";
+            if (threads == max_threads) break;
+        }
+    }
+    return 0;
+}
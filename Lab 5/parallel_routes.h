@@ -0,0 +1,85 @@
+#ifndef PARALLEL_ROUTES_H
+#define PARALLEL_ROUTES_H
+
+#include <algorithm>
+#include <vector>
+#include "graph.h"
+#include "radix_heap.h"
+#include "route_matrix.h"
+#include "work_stealing.h"
+
+// All-pairs routes computed one source at a time across a work-stealing
+// pool. Every source is an independent Dijkstra, so workers share nothing
+// but the read-only graph: each owns its heap and its distance / first-hop
+// scratch rows, allocated once and reused for every source it runs.
+
+struct SpfScratch {
+    std::vector<int> dist;      // INF if unreachable
+    std::vector<int> first_hop; // -1 if unreachable; the source for itself
+    std::vector<int> parent;    // tree parent, likewise
+    RadixHeap heap;
+};
+
+// Single-source shortest paths from `source` into `scratch`.
+inline void shortest_paths(const Graph& graph, int source, SpfScratch& scratch) {
+    std::vector<int>& d = scratch.dist;
+    std::vector<int>& hop = scratch.first_hop;
+    std::vector<int>& par = scratch.parent;
+    d.assign(graph.size(), INF);
+    hop.assign(graph.size(), -1);
+    par.assign(graph.size(), -1);
+    d[source] = 0;
+    hop[source] = source;
+    par[source] = source;
+    scratch.heap.clear();
+    scratch.heap.push(0, source);
+    while (!scratch.heap.empty()) {
+        std::pair<uint32_t, int> top = scratch.heap.pop();
+        int x = top.second;
+        if (static_cast<int>(top.first) != d[x]) continue;
+        for (const Neighbor& nb : graph.neighbors(x)) {
+            int candidate = d[x] + nb.cost;
+            if (candidate < d[nb.node]) {
+                d[nb.node] = candidate;
+                hop[nb.node] = x == source ? nb.node : hop[x];
+                par[nb.node] = x;
+                scratch.heap.push(static_cast<uint32_t>(candidate), nb.node);
+            }
+        }
+    }
+}
+
+// Runs shortest_paths for each of `sources` and calls
+// visit(worker, source, scratch) on the worker that computed it. `visit`
+// runs concurrently on different workers, so it must only write state owned
+// by that worker or by that source.
+template <class Visit>
+void for_each_source(const Graph& graph, const std::vector<int>& sources, WorkStealingPool& pool, Visit visit,
+                     int grain = 16) {
+    std::vector<SpfScratch> scratch(pool.size());
+    pool.parallel_for(static_cast<int>(sources.size()), grain, [&](int worker, int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            shortest_paths(graph, sources[i], scratch[worker]);
+            visit(worker, sources[i], static_cast<const SpfScratch&>(scratch[worker]));
+        }
+    });
+}
+
+// Every node's full routing table into `routes` (one row per source, so
+// workers never write the same row). Unreachable entries become DIST_INF.
+inline void all_pairs_routes(const Graph& graph, RouteMatrix& routes, WorkStealingPool& pool) {
+    int n = graph.size();
+    routes.reset(n);
+    std::vector<int> sources(n);
+    for (int v = 0; v < n; ++v) sources[v] = v;
+    for_each_source(graph, sources, pool, [&](int, int source, const SpfScratch& s) {
+        int32_t* d = routes.dist_row(source);
+        int32_t* hop = routes.next_row(source);
+        for (int v = 0; v < n; ++v) {
+            d[v] = s.dist[v] == INF ? DIST_INF : s.dist[v];
+            hop[v] = s.first_hop[v];
+        }
+    });
+}
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef RADIX_HEAP_H
+#define RADIX_HEAP_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Monotone priority queue for Dijkstra with integer costs. Keys pushed must
+// not be smaller than the last key popped, which Dijkstra guarantees. Entry
+// keys are bucketed by the highest bit in which they differ from the last
+// popped key; popping only redistributes the lowest non-empty bucket, so
+// each entry moves at most 32 times and there are no sift-downs.
+//
+// There is no decrease-key: push again and skip stale entries on pop.
+
+class RadixHeap {
+public:
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+
+    void push(uint32_t key, int value) {
+        buckets[bucket_of(key)].push_back(std::make_pair(key, value));
+        count++;
+    }
+
+    // Smallest key first. Must not be called when empty.
+    std::pair<uint32_t, int> pop() {
+        if (buckets[0].empty()) {
+            int b = 1;
+            while (buckets[b].empty()) b++;
+            uint32_t smallest = buckets[b][0].first;
+            for (const std::pair<uint32_t, int>& entry : buckets[b]) {
+                if (entry.first < smallest) smallest = entry.first;
+            }
+            last = smallest;
+            for (const std::pair<uint32_t, int>& entry : buckets[b]) buckets[bucket_of(entry.first)].push_back(entry);
+            buckets[b].clear();
+        }
+        std::pair<uint32_t, int> top = buckets[0].back();
+        buckets[0].pop_back();
+        count--;
+        return top;
+    }
+
+    // Empties the heap and allows any key again; keeps the bucket storage.
+    void clear() {
+        for (std::vector<std::pair<uint32_t, int>>& bucket : buckets) bucket.clear();
+        count = 0;
+        last = 0;
+    }
+
+private:
+    int bucket_of(uint32_t key) const {
+        return key == last ? 0 : 32 - __builtin_clz(key ^ last);
+    }
+
+    std::vector<std::pair<uint32_t, int>> buckets[33];
+    size_t count = 0;
+    uint32_t last = 0;
+};
+
+#endif
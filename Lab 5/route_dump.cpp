@@ -0,0 +1,196 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <chrono>
+#include <iomanip>
+#include <string>
+#include "graph.h"
+#include "topology_io.h"
+#include "topology_gen.h"
+#include "parallel_routes.h"
+#include "route_dump.h"
+
+using namespace std;
+
+// Writes the full routing table of a topology (route_dump.h), then a diff
+// table holding only the entries a link failure changes. Rows are computed
+// one source at a time (Dijkstra before and after the failure), so memory
+// stays O(N) however large the table. With --compare the same full table is
+// also written the old way, one std::endl per line, to <out>.endl; with
+// --check a binary dump is read back and compared against the routes.
+//
+// The topology is a random graph, a topology_gen.h generator (--topology,
+// sized by --nodes), or a 1-based edge list / CSR file (--input). The failed
+// link defaults to node 1's first link. Nodes on the command line are 0-based.
+// Usage: ./route_dump [--nodes 2000] [--topology kind] [--input file]
+//                     [--fail u v] [--format text|binary] [--out file (.gz)]
+//                     [--compare] [--check] [--seed n]
+
+double seconds_since(chrono::steady_clock::time_point start) {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+// The table as task1 used to print it.
+void write_with_endl(const string& path, const Graph& graph, SpfScratch& scratch) {
+    ofstream out(path);
+    int N = graph.size();
+    for (int i = 0; i < N; ++i) {
+        shortest_paths(graph, i, scratch);
+        for (int j = 0; j < N; ++j) {
+            if (scratch.dist[j] == INF) {
+                out << i + 1 << " " << j + 1 << " INF" << endl;
+            } else {
+                out << i + 1 << " " << j + 1 << " " << scratch.dist[j] << endl;
+            }
+        }
+        out << endl;
+    }
+}
+
+// Reads a binary dump written by main() and checks it against fresh routes.
+bool check_dump(const string& path, const Graph& before, const Graph& after) {
+    RouteDumpReader reader(path);
+    DumpTableKind kind;
+    int nodes;
+    string title;
+    if (!reader.ok() || !reader.next_table(kind, nodes, title) || kind != DUMP_FULL || nodes != before.size()) {
+        return false;
+    }
+    SpfScratch old_routes, new_routes;
+    vector<int> dist, hop;
+    for (int i = 0; i < nodes; ++i) {
+        shortest_paths(before, i, old_routes);
+        if (!reader.row(nodes, dist, hop) || dist != old_routes.dist || hop != old_routes.first_hop) return false;
+    }
+    if (!reader.next_table(kind, nodes, title) || kind != DUMP_DIFF) return false;
+
+    // Apply the diff to each row in turn; every row must end up as the
+    // routes after the failure.
+    int src, dst, distance, next_hop;
+    bool more = reader.entry(src, dst, distance, next_hop);
+    for (int i = 0; i < nodes; ++i) {
+        shortest_paths(before, i, old_routes);
+        shortest_paths(after, i, new_routes);
+        while (more && src == i) {
+            old_routes.dist[dst] = distance;
+            old_routes.first_hop[dst] = next_hop;
+            more = reader.entry(src, dst, distance, next_hop);
+        }
+        if (old_routes.dist != new_routes.dist || old_routes.first_hop != new_routes.first_hop) return false;
+    }
+    return !more;
+}
+
+int main(int argc, char* argv[]) {
+    int nodes = 2000;
+    string topology = "random";
+    string input;
+    int fail_u = -1, fail_v = -1;
+    bool fail_given = false;
+    DumpFormat format = DUMP_TEXT;
+    string out_path = "routes.txt";
+    bool compare = false;
+    bool check = false;
+    uint64_t seed = 1;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--nodes" && i + 1 < argc) {
+            nodes = stoi(argv[++i]);
+        } else if (arg == "--topology" && i + 1 < argc) {
+            topology = argv[++i];
+        } else if (arg == "--input" && i + 1 < argc) {
+            input = argv[++i];
+        } else if (arg == "--fail" && i + 2 < argc) {
+            fail_u = stoi(argv[++i]);
+            fail_v = stoi(argv[++i]);
+            fail_given = true;
+        } else if (arg == "--format" && i + 1 < argc) {
+            string name = argv[++i];
+            if (name != "text" && name != "binary") {
+                cerr << "Unknown format: " << name << "\n";
+                return 1;
+            }
+            format = name == "binary" ? DUMP_BINARY : DUMP_TEXT;
+        } else if (arg == "--out" && i + 1 < argc) {
+            out_path = argv[++i];
+        } else if (arg == "--compare") {
+            compare = true;
+        } else if (arg == "--check") {
+            check = true;
+        } else if (arg == "--seed" && i + 1 < argc) {
+            seed = stoull(argv[++i]);
+        } else {
+            cerr << "Unknown argument: " << arg << "\n";
+            return 1;
+        }
+    }
+
+    Graph graph;
+    if (!load_or_make_topology(input, topology, nodes, seed, graph)) return 1;
+    int N = graph.size();
+    if (!choose_failed_link(graph, fail_given, fail_u, fail_v)) return 1;
+    Graph after = graph;
+    after.remove_link(fail_u, fail_v);
+
+    RouteDumpWriter writer(out_path, format);
+    if (!writer.ok()) {
+        cerr << "Cannot write " << out_path;
+#ifndef ROUTE_DUMP_ZLIB
+        if (out_path.size() > 3 && out_path.compare(out_path.size() - 3, 3, ".gz") == 0) {
+            cerr << " (gzip output needs -DROUTE_DUMP_ZLIB and -lz)";
+        }
+#endif
+        cerr << "\n";
+        return 1;
+    }
+    cout << N << " nodes, " << graph.num_edges() << " links, fail " << fail_u << "-" << fail_v << "\n";
+
+    SpfScratch old_routes, new_routes;
+    auto start = chrono::steady_clock::now();
+    writer.begin_table(DUMP_FULL, N, "routes of " + to_string(N) + " nodes");
+    for (int i = 0; i < N; ++i) {
+        shortest_paths(graph, i, old_routes);
+        writer.row(i, old_routes.dist.data(), old_routes.first_hop.data(), N);
+    }
+    writer.end_table();
+    double full_time = seconds_since(start);
+    uint64_t full_bytes = writer.bytes();
+    uint64_t full_entries = writer.entries;
+
+    start = chrono::steady_clock::now();
+    writer.begin_table(DUMP_DIFF, N, "after link " + to_string(fail_u + 1) + "-" + to_string(fail_v + 1) + " failed");
+    for (int i = 0; i < N; ++i) {
+        shortest_paths(graph, i, old_routes);
+        shortest_paths(after, i, new_routes);
+        writer.row_diff(i, old_routes.dist.data(), old_routes.first_hop.data(), new_routes.dist.data(),
+                        new_routes.first_hop.data(), N);
+    }
+    writer.end_table();
+    if (!writer.close()) {
+        cerr << "Error writing " << out_path << "\n";
+        return 1;
+    }
+    double diff_time = seconds_since(start);
+
+    cout << fixed << setprecision(3) << "  full table   " << setw(11) << full_entries << " entries  " << setw(9)
+         << full_bytes / 1e6 << " MB  " << setw(8) << full_time << " s (incl. routes)\n"
+         << "  diff table   " << setw(11) << writer.entries - full_entries << " entries  " << setw(9)
+         << (writer.bytes() - full_bytes) / 1e6 << " MB  " << setw(8) << diff_time << " s (incl. routes x2)\n"
+         << "  written to " << out_path << "\n";
+
+    if (compare) {
+        string endl_path = out_path + ".endl";
+        start = chrono::steady_clock::now();
+        write_with_endl(endl_path, graph, old_routes);
+        double endl_time = seconds_since(start);
+        cout << "  std::endl per line (" << endl_path << "): " << endl_time << " s\n";
+    }
+    if (check) {
+        if (format != DUMP_BINARY) {
+            cerr << "--check reads binary dumps only\n";
+            return 1;
+        }
+        cout << "  read back and applied: " << (check_dump(out_path, graph, after) ? "yes" : "NO") << "\n";
+    }
+    return 0;
+}
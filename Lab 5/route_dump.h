@@ -0,0 +1,321 @@
+#ifndef ROUTE_DUMP_H
+#define ROUTE_DUMP_H
+
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#ifdef ROUTE_DUMP_ZLIB
+#include <zlib.h>
+#endif
+#include "graph.h"
+
+// Routing-table dumps, written one source row at a time so no N x N table
+// has to exist in memory.
+//
+// Output goes through a 1 MB buffer that is only handed to the file when it
+// fills, never per line. Two formats:
+//   text    "src dst distance [next hop]" per entry, nodes numbered from
+//           `base`, INF for unreachable; a full table leaves a blank line
+//           after each row (the task1 layout). Diff entries read
+//           "src dst old -> new [next hop]".
+//   binary  header "RTDP", version; then per table: kind (0 full, 1 diff),
+//           node count, title length and title. A full table is every row
+//           in order as int32 pairs {distance, next hop}; a diff table is
+//           int32 records {src, dst, distance, next hop} ending with src -1.
+//           Unreachable is distance -1 and nodes are 0-based.
+// A path ending in ".gz" is gzip-compressed; that needs the zlib build
+// (-DROUTE_DUMP_ZLIB ... -lz) and fails to open otherwise. "-" is stdout.
+//
+// A diff table lists only the entries whose distance or next hop changed
+// between two versions of each row, e.g. before and after a link failure.
+
+enum DumpFormat { DUMP_TEXT, DUMP_BINARY };
+
+enum DumpTableKind { DUMP_FULL = 0, DUMP_DIFF = 1 };
+
+// Buffered byte sink over a FILE* or, in the zlib build, a gzFile.
+class DumpOutput {
+public:
+    explicit DumpOutput(const std::string& path) : buffer(1 << 20) {
+        bool gz = path.size() > 3 && path.compare(path.size() - 3, 3, ".gz") == 0;
+        if (gz) {
+#ifdef ROUTE_DUMP_ZLIB
+            zfile = gzopen(path.c_str(), "wb1");
+#endif
+        } else if (path == "-") {
+            file = stdout;
+        } else {
+            file = std::fopen(path.c_str(), "wb");
+        }
+    }
+    ~DumpOutput() { close(); }
+    DumpOutput(const DumpOutput&) = delete;
+    DumpOutput& operator=(const DumpOutput&) = delete;
+
+    bool ok() const {
+#ifdef ROUTE_DUMP_ZLIB
+        if (zfile) return !failed;
+#endif
+        return file != nullptr && !failed;
+    }
+
+    // Room for at least `count` more bytes at reserve()'s result.
+    char* reserve(size_t count) {
+        if (buffer.size() - used < count) flush();
+        return buffer.data() + used;
+    }
+    void commit(char* end) { used = end - buffer.data(); }
+
+    void write(const void* data, size_t count) {
+        if (count > buffer.size() - used) flush();
+        if (count > buffer.size()) {
+            sink(static_cast<const char*>(data), count);
+            return;
+        }
+        std::memcpy(buffer.data() + used, data, count);
+        used += count;
+    }
+
+    uint64_t bytes() const { return written + used; }
+
+    bool close() {
+        flush();
+#ifdef ROUTE_DUMP_ZLIB
+        if (zfile) {
+            if (gzclose(zfile) != Z_OK) failed = true;
+            zfile = nullptr;
+        }
+#endif
+        if (file) {
+            if (file == stdout ? std::fflush(file) != 0 : std::fclose(file) != 0) failed = true;
+            file = nullptr;
+        }
+        return !failed;
+    }
+
+private:
+    void flush() {
+        sink(buffer.data(), used);
+        used = 0;
+    }
+
+    void sink(const char* data, size_t count) {
+        if (count == 0) return;
+        written += count;
+#ifdef ROUTE_DUMP_ZLIB
+        if (zfile) {
+            if (gzwrite(zfile, data, static_cast<unsigned>(count)) != static_cast<int>(count)) failed = true;
+            return;
+        }
+#endif
+        if (file && std::fwrite(data, 1, count, file) != count) failed = true;
+    }
+
+    FILE* file = nullptr;
+#ifdef ROUTE_DUMP_ZLIB
+    gzFile zfile = nullptr;
+#endif
+    std::vector<char> buffer;
+    size_t used = 0;
+    uint64_t written = 0;
+    bool failed = false;
+};
+
+class RouteDumpWriter {
+public:
+    RouteDumpWriter(const std::string& path, DumpFormat format, int base = 1)
+        : out(path), format(format), base(base) {
+        if (format == DUMP_BINARY) {
+            uint32_t version = 1;
+            out.write("RTDP", 4);
+            out.write(&version, sizeof(version));
+        }
+    }
+
+    bool ok() const { return out.ok(); }
+
+    // Starts a table. Distances at or above `unreachable` are written as
+    // unreachable (INF for Graph-based routes, DIST_INF for a RouteMatrix).
+    // The text title is a "# ..." line; an empty title writes none.
+    void begin_table(DumpTableKind kind, int nodes, const std::string& title, int unreachable = INF) {
+        table_kind = kind;
+        limit = unreachable;
+        if (format == DUMP_BINARY) {
+            uint32_t head[3] = {static_cast<uint32_t>(kind), static_cast<uint32_t>(nodes),
+                                static_cast<uint32_t>(title.size())};
+            out.write(head, sizeof(head));
+            out.write(title.data(), title.size());
+        } else if (!title.empty()) {
+            out.write("# ", 2);
+            out.write(title.data(), title.size());
+            out.write("\n", 1);
+        }
+    }
+
+    // Full table: row `src` of `nodes` entries; rows must come in order for
+    // the binary format. `hop` may be null (no next-hop column, and -1 in
+    // binary).
+    void row(int src, const int* dist, const int* hop, int nodes) {
+        if (format == DUMP_BINARY) {
+            for (int j = 0; j < nodes; ++j) {
+                int32_t pair[2] = {dist[j] >= limit ? -1 : dist[j], hop ? hop[j] : -1};
+                out.write(pair, sizeof(pair));
+            }
+        } else {
+            for (int j = 0; j < nodes; ++j) {
+                char* p = out.reserve(64);
+                p = put(p, src + base, ' ');
+                p = put(p, j + base, ' ');
+                p = put_distance(p, dist[j], hop ? ' ' : '\n');
+                if (hop) p = put(p, hop[j] < 0 ? -1 : hop[j] + base, '\n');
+                out.commit(p);
+            }
+            out.write("\n", 1);
+        }
+        entries += nodes;
+    }
+
+    // Diff table: the entries of row `src` that differ between the old and
+    // new versions. Rows may come in any order.
+    void row_diff(int src, const int* old_dist, const int* old_hop, const int* dist, const int* hop, int nodes) {
+        for (int j = 0; j < nodes; ++j) {
+            bool was = old_dist[j] < limit, is = dist[j] < limit;
+            bool same = was == is && (!is || old_dist[j] == dist[j]) && (!hop || old_hop[j] == hop[j]);
+            if (!same) entry_diff(src, j, old_dist[j], dist[j], hop ? hop[j] : -1, hop != nullptr);
+        }
+    }
+
+    // One changed entry of a diff table.
+    void entry_diff(int src, int dst, int old_distance, int distance, int next_hop, bool with_hop = true) {
+        if (format == DUMP_BINARY) {
+            int32_t record[4] = {src, dst, distance >= limit ? -1 : distance, next_hop};
+            out.write(record, sizeof(record));
+        } else {
+            char* p = out.reserve(96);
+            p = put(p, src + base, ' ');
+            p = put(p, dst + base, ' ');
+            p = put_distance(p, old_distance, ' ');
+            *p++ = '-';
+            *p++ = '>';
+            *p++ = ' ';
+            p = put_distance(p, distance, with_hop ? ' ' : '\n');
+            if (with_hop) p = put(p, next_hop < 0 ? -1 : next_hop + base, '\n');
+            out.commit(p);
+        }
+        entries++;
+    }
+
+    void end_table() {
+        if (format == DUMP_BINARY && table_kind == DUMP_DIFF) {
+            int32_t end[4] = {-1, -1, -1, -1};
+            out.write(end, sizeof(end));
+        }
+    }
+
+    bool close() { return out.close(); }
+
+    uint64_t bytes() const { return out.bytes(); } // before compression
+    uint64_t entries = 0;
+
+private:
+    static char* put(char* p, int value, char separator) {
+        p = std::to_chars(p, p + 16, value).ptr;
+        *p++ = separator;
+        return p;
+    }
+
+    char* put_distance(char* p, int distance, char separator) const {
+        if (distance < limit) return put(p, distance, separator);
+        std::memcpy(p, "INF", 3);
+        p[3] = separator;
+        return p + 4;
+    }
+
+    DumpOutput out;
+    DumpFormat format;
+    int base;
+    DumpTableKind table_kind = DUMP_FULL;
+    int limit = INF;
+};
+
+// Reads the binary format back (plain files, or .gz in the zlib build).
+class RouteDumpReader {
+public:
+    explicit RouteDumpReader(const std::string& path) {
+#ifdef ROUTE_DUMP_ZLIB
+        zfile = gzopen(path.c_str(), "rb"); // also reads uncompressed files
+#else
+        file = std::fopen(path.c_str(), "rb");
+#endif
+        char magic[4];
+        uint32_t version = 0;
+        valid = read(magic, 4) && read(&version, sizeof(version)) && std::memcmp(magic, "RTDP", 4) == 0 &&
+                version == 1;
+    }
+    ~RouteDumpReader() {
+#ifdef ROUTE_DUMP_ZLIB
+        if (zfile) gzclose(zfile);
+#endif
+        if (file) std::fclose(file);
+    }
+    RouteDumpReader(const RouteDumpReader&) = delete;
+    RouteDumpReader& operator=(const RouteDumpReader&) = delete;
+
+    bool ok() const { return valid; }
+
+    // Header of the next table; false at the end of the file.
+    bool next_table(DumpTableKind& kind, int& nodes, std::string& title) {
+        uint32_t head[3];
+        if (!valid || !read(head, sizeof(head))) return false;
+        kind = static_cast<DumpTableKind>(head[0]);
+        nodes = static_cast<int>(head[1]);
+        title.resize(head[2]);
+        return read(&title[0], title.size());
+    }
+
+    // Next row of a full table; unreachable distances come back as INF.
+    bool row(int nodes, std::vector<int>& dist, std::vector<int>& hop) {
+        pairs.resize(2 * static_cast<size_t>(nodes));
+        if (!read(pairs.data(), pairs.size() * sizeof(int32_t))) return false;
+        dist.resize(nodes);
+        hop.resize(nodes);
+        for (int j = 0; j < nodes; ++j) {
+            dist[j] = pairs[2 * j] < 0 ? INF : pairs[2 * j];
+            hop[j] = pairs[2 * j + 1];
+        }
+        return true;
+    }
+
+    // Next entry of a diff table; false after its last entry.
+    bool entry(int& src, int& dst, int& distance, int& next_hop) {
+        int32_t record[4];
+        if (!read(record, sizeof(record)) || record[0] < 0) return false;
+        src = record[0];
+        dst = record[1];
+        distance = record[2] < 0 ? INF : record[2];
+        next_hop = record[3];
+        return true;
+    }
+
+private:
+    bool read(void* data, size_t count) {
+        if (count == 0) return true;
+#ifdef ROUTE_DUMP_ZLIB
+        return zfile && gzread(zfile, data, static_cast<unsigned>(count)) == static_cast<int>(count);
+#else
+        return file && std::fread(data, 1, count, file) == count;
+#endif
+    }
+
+    FILE* file = nullptr;
+#ifdef ROUTE_DUMP_ZLIB
+    gzFile zfile = nullptr;
+#endif
+    std::vector<int32_t> pairs;
+    bool valid = false;
+};
+
+#endif
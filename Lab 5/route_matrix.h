@@ -0,0 +1,163 @@
+#ifndef ROUTE_MATRIX_H
+#define ROUTE_MATRIX_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+// All-pairs routing table as two contiguous row-major matrices (distance and
+// next hop), with rows padded to a multiple of 16 entries so every row starts
+// on a 64-byte boundary relative to the first and the kernels never need a
+// scalar tail.
+//
+// "Infinity" is DIST_INF = 2^30 - 1 rather than INT_MAX: the sum of two
+// entries is at most 2 * DIST_INF, which still fits in an int32, so
+// d[i][k] + d[k][j] can be formed without the `!= INF` guards and the min()
+// keeps every entry at or below DIST_INF. Real path costs must stay below it.
+
+constexpr int32_t DIST_INF = 0x3FFFFFFF;
+
+class RouteMatrix {
+public:
+    explicit RouteMatrix(int num_nodes = 0) { reset(num_nodes); }
+
+    // Every node reaches itself at cost 0 and nothing else.
+    void reset(int num_nodes) {
+        n = num_nodes;
+        stride = (num_nodes + 15) & ~15;
+        dist.assign(static_cast<size_t>(n) * stride, DIST_INF);
+        next.assign(static_cast<size_t>(n) * stride, -1);
+        for (int i = 0; i < n; ++i) {
+            distance(i, i) = 0;
+            next_hop(i, i) = i;
+        }
+    }
+
+    // Direct link in both directions.
+    void set_link(int u, int v, int cost) {
+        distance(u, v) = cost;
+        distance(v, u) = cost;
+        next_hop(u, v) = v;
+        next_hop(v, u) = u;
+    }
+
+    int32_t& distance(int i, int j) { return dist[static_cast<size_t>(i) * stride + j]; }
+    int32_t distance(int i, int j) const { return dist[static_cast<size_t>(i) * stride + j]; }
+    int32_t& next_hop(int i, int j) { return next[static_cast<size_t>(i) * stride + j]; }
+    int32_t next_hop(int i, int j) const { return next[static_cast<size_t>(i) * stride + j]; }
+
+    int32_t* dist_row(int i) { return &dist[static_cast<size_t>(i) * stride]; }
+    int32_t* next_row(int i) { return &next[static_cast<size_t>(i) * stride]; }
+
+    int size() const { return n; }
+    int row_stride() const { return stride; }
+
+private:
+    int n = 0;
+    int stride = 0;
+    std::vector<int32_t> dist;
+    std::vector<int32_t> next;
+};
+
+struct RouteLink {
+    int u, v, cost;
+};
+
+// Resets `m` to the direct links in `links` except u-v (in either
+// direction), ready for floyd_warshall(). After a link fails the tables
+// have to be rebuilt like this: clearing only the routes whose first hop is
+// the dead link leaves longer routes across it in place, and the next pass
+// reuses them.
+inline void rebuild_without_link(RouteMatrix& m, const std::vector<RouteLink>& links, int u, int v) {
+    m.reset(m.size());
+    for (const RouteLink& l : links) {
+        if ((l.u == u && l.v == v) || (l.u == v && l.v == u)) continue;
+        m.set_link(l.u, l.v, l.cost);
+    }
+}
+
+// d[i][j] = min(d[i][j], dik + dk[j]) for j in [0, count), taking next hop
+// `hop` wherever the path through k is strictly shorter. `count` is a
+// multiple of 8.
+inline void relax_row(int32_t* di, int32_t* ni, const int32_t* dk, int32_t dik, int32_t hop, int count) {
+#ifdef __AVX2__
+    __m256i via = _mm256_set1_epi32(dik);
+    __m256i hops = _mm256_set1_epi32(hop);
+    for (int j = 0; j < count; j += 8) {
+        __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(di + j));
+        __m256i candidate = _mm256_add_epi32(via, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dk + j)));
+        __m256i shorter = _mm256_cmpgt_epi32(d, candidate);
+        if (_mm256_testz_si256(shorter, shorter)) continue;
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(di + j), _mm256_min_epi32(d, candidate));
+        __m256i nx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ni + j));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(ni + j), _mm256_blendv_epi8(nx, hops, shorter));
+    }
+#else
+    for (int j = 0; j < count; ++j) {
+        int32_t candidate = dik + dk[j];
+        bool shorter = candidate < di[j];
+        di[j] = shorter ? candidate : di[j];
+        ni[j] = shorter ? hop : ni[j];
+    }
+#endif
+}
+
+// Relaxes rows [i0, i1) through intermediates [k0, k1) over columns
+// [j0, j1). With `k_outer` the intermediate loop is outermost, which the
+// diagonal and pivot row/column blocks need because they read entries the
+// same pass writes; the remaining blocks only read finished pivot blocks and
+// keep row i hot instead.
+inline void relax_block(RouteMatrix& m, int i0, int i1, int j0, int j1, int k0, int k1, bool k_outer) {
+    if (k_outer) {
+        for (int k = k0; k < k1; ++k) {
+            const int32_t* dk = m.dist_row(k) + j0;
+            for (int i = i0; i < i1; ++i) {
+                int32_t dik = m.distance(i, k);
+                if (dik >= DIST_INF || i == k) continue;
+                relax_row(m.dist_row(i) + j0, m.next_row(i) + j0, dk, dik, m.next_hop(i, k), j1 - j0);
+            }
+        }
+        return;
+    }
+    for (int i = i0; i < i1; ++i) {
+        int32_t* di = m.dist_row(i);
+        int32_t* ni = m.next_row(i);
+        for (int k = k0; k < k1; ++k) {
+            int32_t dik = di[k];
+            if (dik >= DIST_INF) continue;
+            relax_row(di + j0, ni + j0, m.dist_row(k) + j0, dik, ni[k], j1 - j0);
+        }
+    }
+}
+
+// Blocked Floyd-Warshall (diagonal block, then its row and column, then the
+// rest) so each phase works on `block` x `block` tiles that stay in cache.
+// `block` must be a multiple of 16.
+inline void floyd_warshall(RouteMatrix& m, int block = 64) {
+    int n = m.size();
+    int stride = m.row_stride();
+    for (int k0 = 0; k0 < n; k0 += block) {
+        int k1 = std::min(k0 + block, n);
+        int kj1 = std::min(k0 + block, stride);
+        relax_block(m, k0, k1, k0, kj1, k0, k1, true);
+        for (int b = 0; b < stride; b += block) {
+            if (b == k0) continue;
+            int j1 = std::min(b + block, stride);
+            relax_block(m, k0, k1, b, j1, k0, k1, true);            // pivot row
+            relax_block(m, b, std::min(b + block, n), k0, kj1, k0, k1, true); // pivot column
+        }
+        for (int i0 = 0; i0 < n; i0 += block) {
+            if (i0 == k0) continue;
+            int i1 = std::min(i0 + block, n);
+            for (int j0 = 0; j0 < stride; j0 += block) {
+                if (j0 == k0) continue;
+                relax_block(m, i0, i1, j0, std::min(j0 + block, stride), k0, k1, false);
+            }
+        }
+    }
+}
+
+#endif
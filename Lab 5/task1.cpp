@@ -3,61 +3,19 @@
 #include <tuple>
 #include <climits>
 #include <algorithm>
+#include "graph.h"
+#include "dv_engine.h"
+#include "route_dump.h"
 
 using namespace std;
 
-const int INF = INT_MAX;
-
-// Function to initialize the routing table
-void initialize_routing_table(int N, vector<vector<int>>& routing_table, vector<tuple<int, int, int>>& edges) {
-    // Initialize routing table with infinity
+// Copy the converged routes out of the engine (0-based) into the N x N table
+void fill_routing_table(int N, const DistanceVectorEngine& engine, vector<vector<int>>& routing_table) {
     for (int i = 0; i < N; ++i) {
         for (int j = 0; j < N; ++j) {
-            if (i == j) {
-                routing_table[i][j] = 0;
-            } else {
-                routing_table[i][j] = INF;
-            }
+            routing_table[i][j] = engine.distance(i, j);
         }
     }
-
-    // Set the cost between directly connected nodes
-    for (auto& edge : edges) {
-        int u, v, cost;
-        tie(u, v, cost) = edge;
-        routing_table[u-1][v-1] = cost;
-        routing_table[v-1][u-1] = cost;
-    }
-}
-
-// Bellman-Ford-like algorithm to update the routing table
-void bellman_ford(int N, vector<vector<int>>& routing_table, vector<tuple<int, int, int>>& edges) {
-    for (int k = 0; k < N-1; ++k) {  // Run N-1 times
-        for (auto& edge : edges) {
-            int u, v, cost;
-            tie(u, v, cost) = edge;
-            u--; v--;  // Convert to 0-indexed
-            for (int node = 0; node < N; ++node) {
-                if (routing_table[node][u] != INF) {
-                    routing_table[node][v] = min(routing_table[node][v], routing_table[node][u] + cost);
-                }
-                if (routing_table[node][v] != INF) {
-                    routing_table[node][u] = min(routing_table[node][u], routing_table[node][v] + cost);
-                }
-            }
-        }
-    }
-}
-
-// Simulate link failure by removing an edge
-void simulate_link_failure(vector<tuple<int, int, int>>& edges, int failed_u, int failed_v) {
-    edges.erase(remove_if(edges.begin(), edges.end(),
-        [=](tuple<int, int, int>& edge) {
-            int u, v, cost;
-            tie(u, v, cost) = edge;
-            return (u == failed_u && v == failed_v) || (u == failed_v && v == failed_u);
-        }),
-        edges.end());
 }
 
 // Check for count-to-infinity problem
@@ -70,19 +28,16 @@ bool check_count_to_infinity(const vector<vector<int>>& routing_table) {
     return false;
 }
 
-// Print the routing table for each node in the specified format
+// Print the routing table: "src dst distance" per entry, a blank line after
+// each node. Written through route_dump.h's buffer, not flushed per line.
 void print_routing_table(int N, const vector<vector<int>>& routing_table) {
+    cout.flush();
+    RouteDumpWriter writer("-", DUMP_TEXT);
+    writer.begin_table(DUMP_FULL, N, "");
     for (int i = 0; i < N; ++i) {
-        cout << N << " " << N - 1 << "  # " << N << " nodes, " << N - 1 << " edges" << endl;
-        for (int j = 0; j < N; ++j) {
-            if (routing_table[i][j] == INF) {
-                cout << i + 1 << " " << j + 1 << " INF" << endl;
-            } else {
-                cout << i + 1 << " " << j + 1 << " " << routing_table[i][j] << endl;
-            }
-        }
-        cout << endl;
+        writer.row(i, routing_table[i].data(), nullptr, N);
     }
+    writer.close();
 }
 
 int main() {
@@ -104,11 +59,17 @@ int main() {
     // Routing table (N x N matrix)
     vector<vector<int>> routing_table(N, vector<int>(N, INF));
 
-    // Initialize the routing table
-    initialize_routing_table(N, routing_table, edges);
-
-    // Run the DVR algorithm (Bellman-Ford style)
-    bellman_ford(N, routing_table, edges);
+    // Run the DVR algorithm on the sparse engine (nodes are 0-indexed inside)
+    Graph graph(N);
+    for (auto& edge : edges) {
+        int u, v, cost;
+        tie(u, v, cost) = edge;
+        // A repeated edge keeps its cheapest cost
+        if (cost < graph.link_cost(u - 1, v - 1)) graph.set_link(u - 1, v - 1, cost);
+    }
+    DistanceVectorEngine engine(graph);
+    engine.converge();
+    fill_routing_table(N, engine, routing_table);
 
     // Print the routing table before link failure
     cout << "Routing Table before Link Failure:\n";
@@ -118,11 +79,16 @@ int main() {
     int failed_u, failed_v;
     cout << "Enter the nodes between which the link has failed (e.g., 4 5): ";
     cin >> failed_u >> failed_v;
-    simulate_link_failure(edges, failed_u, failed_v);
 
-    // Re-run DVR after the link failure
-    initialize_routing_table(N, routing_table, edges);
-    bellman_ford(N, routing_table, edges);
+    // Only the routes that used the failed link are recomputed; a link the
+    // graph does not have leaves the tables as they are
+    if (failed_u < 1 || failed_u > N || failed_v < 1 || failed_v > N ||
+        graph.link_cost(failed_u - 1, failed_v - 1) == INF) {
+        cout << "No such link: " << failed_u << "-" << failed_v << "\n";
+    } else {
+        engine.fail_link(failed_u - 1, failed_v - 1);
+        fill_routing_table(N, engine, routing_table);
+    }
 
     // Print the routing table after link failure
     cout << "Routing Table after Link Failure (" << failed_u << "-" << failed_v << "):\n";
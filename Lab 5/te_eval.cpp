@@ -0,0 +1,243 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <iomanip>
+#include <random>
+#include <algorithm>
+#include <string>
+#include "graph.h"
+#include "topology_io.h"
+#include "topology_gen.h"
+#include "parallel_routes.h"
+#include "multipath.h"
+
+using namespace std;
+
+// Multipath routing and load balancing (multipath.h).
+//  1. ECMP routing tables for a sample of sources: how many destinations
+//     have more than one equal-cost next hop, and what the bitsets cost.
+//  2. A random traffic matrix routed on single shortest paths, with ECMP,
+//     and split over the k shortest paths (Yen) for k = 2..K; reports the
+//     maximum link utilization (every link direction has capacity 1, and
+//     each demand is uniform in [0, 2 * volume]).
+// --paths s t prints the K shortest paths between two nodes; --check
+// verifies ECMP sets and Yen's paths against brute force.
+//
+// The topology is a random graph, a topology_gen.h generator (--topology,
+// sized by --nodes; fat-tree shows ECMP best), or a 1-based edge list / CSR
+// file (--input). Nodes on the command line are 0-based.
+// Usage: ./te_eval [--nodes 1000] [--topology kind] [--input file]
+//                  [--demands 2000] [--k 4] [--volume 0.01] [--paths s t]
+//                  [--check] [--seed n]
+
+double seconds_since(chrono::steady_clock::time_point start) {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+// ECMP sets of `source` against the definition: neighbor y is a next hop
+// to d iff cost(source, y) + dist(y, d) == dist(source, d).
+bool check_ecmp(const Graph& graph, int source, const EcmpScratch& ecmp) {
+    SpfScratch from_source, from_neighbor;
+    shortest_paths(graph, source, from_source);
+    if (from_source.dist != ecmp.dist) return false;
+    const vector<Neighbor>& links = graph.neighbors(source);
+    for (size_t i = 0; i < links.size(); ++i) {
+        shortest_paths(graph, links[i].node, from_neighbor);
+        for (int d = 0; d < graph.size(); ++d) {
+            if (d == source) continue;
+            bool tight = from_neighbor.dist[d] != INF && from_source.dist[d] != INF &&
+                         links[i].cost + from_neighbor.dist[d] == from_source.dist[d];
+            bool in_set = (ecmp.hop_set(d)[i / 64] >> (i % 64)) & 1;
+            if (tight != in_set) return false;
+        }
+    }
+    return true;
+}
+
+// Every simple path from s to t, by cost (small graphs only).
+void all_simple_paths(const Graph& graph, int x, int t, int cost, vector<char>& on_path, vector<int>& costs) {
+    if (x == t) {
+        costs.push_back(cost);
+        return;
+    }
+    on_path[x] = 1;
+    for (const Neighbor& nb : graph.neighbors(x)) {
+        if (!on_path[nb.node]) all_simple_paths(graph, nb.node, t, cost + nb.cost, on_path, costs);
+    }
+    on_path[x] = 0;
+}
+
+// Yen's paths: loopless, distinct, priced right, in cost order, starting at
+// the shortest distance; on small graphs the costs must match brute force.
+bool check_paths(const Graph& graph, int s, int t, const vector<WeightedPath>& paths, int k) {
+    SpfScratch scratch;
+    shortest_paths(graph, s, scratch);
+    if (scratch.dist[t] == INF) return paths.empty();
+    if (paths.empty() || paths[0].cost != scratch.dist[t]) return false;
+    for (size_t p = 0; p < paths.size(); ++p) {
+        const vector<int>& nodes = paths[p].nodes;
+        if (nodes.front() != s || nodes.back() != t) return false;
+        vector<int> sorted = nodes;
+        sort(sorted.begin(), sorted.end());
+        if (adjacent_find(sorted.begin(), sorted.end()) != sorted.end()) return false;
+        int cost = 0;
+        for (size_t i = 0; i + 1 < nodes.size(); ++i) {
+            int c = graph.link_cost(nodes[i], nodes[i + 1]);
+            if (c == INF) return false;
+            cost += c;
+        }
+        if (cost != paths[p].cost || (p > 0 && paths[p].cost < paths[p - 1].cost)) return false;
+        for (size_t q = 0; q < p; ++q) {
+            if (paths[q].nodes == nodes) return false;
+        }
+    }
+    if (graph.size() <= 12) {
+        vector<char> on_path(graph.size(), 0);
+        vector<int> costs;
+        all_simple_paths(graph, s, t, 0, on_path, costs);
+        sort(costs.begin(), costs.end());
+        if (paths.size() != min<size_t>(k, costs.size())) return false;
+        for (size_t p = 0; p < paths.size(); ++p) {
+            if (paths[p].cost != costs[p]) return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    int nodes = 1000;
+    string topology = "random";
+    string input;
+    int demand_count = 2000;
+    int K = 4;
+    double volume = 0.01;
+    int path_s = -1, path_t = -1;
+    bool check = false;
+    uint64_t seed = 1;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--nodes" && i + 1 < argc) {
+            nodes = stoi(argv[++i]);
+        } else if (arg == "--topology" && i + 1 < argc) {
+            topology = argv[++i];
+        } else if (arg == "--input" && i + 1 < argc) {
+            input = argv[++i];
+        } else if (arg == "--demands" && i + 1 < argc) {
+            demand_count = stoi(argv[++i]);
+        } else if (arg == "--k" && i + 1 < argc) {
+            K = stoi(argv[++i]);
+        } else if (arg == "--volume" && i + 1 < argc) {
+            volume = stod(argv[++i]);
+        } else if (arg == "--paths" && i + 2 < argc) {
+            path_s = stoi(argv[++i]);
+            path_t = stoi(argv[++i]);
+        } else if (arg == "--check") {
+            check = true;
+        } else if (arg == "--seed" && i + 1 < argc) {
+            seed = stoull(argv[++i]);
+        } else {
+            cerr << "Unknown argument: " << arg << "\n";
+            return 1;
+        }
+    }
+
+    Graph graph;
+    if (!load_or_make_topology(input, topology, nodes, seed, graph)) return 1;
+    int N = graph.size();
+    if (N < 2) {
+        cerr << "Need at least 2 nodes\n";
+        return 1;
+    }
+    mt19937_64 gen(seed);
+    cout << N << " nodes, " << graph.num_edges() << " links\n\n";
+
+    // 1. ECMP tables.
+    int sampled = min(N, 200);
+    EcmpScratch ecmp;
+    uint64_t pairs = 0, multipath = 0, hop_total = 0, table_bytes = 0;
+    int widest = 0;
+    bool ecmp_ok = true;
+    double ecmp_time = 0;
+    for (int k = 0; k < sampled; ++k) {
+        int source = static_cast<int>(static_cast<int64_t>(k) * N / sampled);
+        auto start = chrono::steady_clock::now();
+        ecmp_paths(graph, source, ecmp);
+        ecmp_time += seconds_since(start);
+        table_bytes += ecmp.hops.size() * sizeof(uint64_t);
+        for (int d = 0; d < N; ++d) {
+            if (d == source || ecmp.dist[d] == INF) continue;
+            int count = ecmp.hop_count(d);
+            pairs++;
+            multipath += count > 1;
+            hop_total += count;
+            widest = max(widest, count);
+        }
+        if (check && k < 20) ecmp_ok = ecmp_ok && check_ecmp(graph, source, ecmp);
+    }
+    cout << "ECMP tables, " << sampled << " sources (" << fixed << setprecision(2) << ecmp_time * 1e3 / sampled
+         << " ms each):\n"
+         << "  destinations with several next hops  " << setprecision(1) << 100.0 * multipath / max<uint64_t>(pairs, 1)
+         << "%\n  mean / max next hops                 " << setprecision(2) << double(hop_total) / max<uint64_t>(pairs, 1)
+         << " / " << widest << "\n  next-hop sets per source             " << setprecision(1)
+         << table_bytes / 1024.0 / sampled << " KB (single next hop: " << N * sizeof(int) / 1024.0 << " KB)\n";
+    if (check) cout << "  check against the definition (20 sources): " << (ecmp_ok ? "yes" : "NO") << "\n";
+
+    // 2. Traffic matrix.
+    vector<Demand> demands;
+    uniform_real_distribution<double> amount(0, 2 * volume);
+    while (static_cast<int>(demands.size()) < demand_count) {
+        int s = static_cast<int>(gen() % N), t = static_cast<int>(gen() % N);
+        if (s != t) demands.push_back(Demand{s, t, amount(gen)});
+    }
+    double total_volume = 0;
+    for (const Demand& d : demands) total_volume += d.volume;
+    cout << "\n" << demands.size() << " demands, mean volume " << setprecision(3) << volume
+         << " of a link's capacity\n"
+         << "  routing               max util   mean util (used)   links used   link-hops   time (s)\n";
+    auto report = [&](const string& name, const LinkLoads& loads, double time) {
+        size_t used = loads.used_links();
+        cout << "  " << left << setw(20) << name << right << setprecision(1) << setw(10) << loads.max_load() * 100
+             << "%" << setw(18) << (used ? loads.total() / used * 100 : 0) << "%" << setw(13) << used << setw(12)
+             << setprecision(2) << loads.total() / total_volume << setprecision(3) << setw(11) << time << "\n";
+    };
+    {
+        LinkLoads loads(graph);
+        auto start = chrono::steady_clock::now();
+        route_single_path(graph, demands, loads);
+        report("single path", loads, seconds_since(start));
+    }
+    {
+        LinkLoads loads(graph);
+        auto start = chrono::steady_clock::now();
+        route_ecmp(graph, demands, loads);
+        report("ECMP", loads, seconds_since(start));
+    }
+    for (int k = 2; k <= K; ++k) {
+        LinkLoads loads(graph);
+        auto start = chrono::steady_clock::now();
+        route_k_shortest(graph, demands, k, loads);
+        report(to_string(k) + " shortest paths", loads, seconds_since(start));
+    }
+    cout << "(link-hops: mean hops a unit of traffic travels)\n";
+
+    if (check) {
+        KShortestPaths finder(graph);
+        bool paths_ok = true;
+        for (size_t i = 0; i < demands.size() && i < 200; ++i) {
+            paths_ok = paths_ok && check_paths(graph, demands[i].src, demands[i].dst,
+                                               finder.find(demands[i].src, demands[i].dst, K), K);
+        }
+        cout << "Yen's paths checked (200 demands): " << (paths_ok ? "yes" : "NO") << "\n";
+    }
+
+    if (path_s >= 0 && path_s < N && path_t >= 0 && path_t < N) {
+        KShortestPaths finder(graph);
+        cout << "\n" << K << " shortest paths " << path_s << " -> " << path_t << ":\n";
+        for (const WeightedPath& p : finder.find(path_s, path_t, K)) {
+            cout << "  cost " << setw(4) << p.cost << ":";
+            for (int v : p.nodes) cout << " " << v;
+            cout << "\n";
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,141 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <chrono>
+#include <iomanip>
+#include <string>
+#include "graph.h"
+#include "topology_io.h"
+#include "topology_gen.h"
+
+using namespace std;
+
+// Topology files for the routing programs (topology_io.h, topology_gen.h).
+//   gen <random|waxman|ba|grid|fat-tree> <size> <out> [--binary] [--base b] [--seed n]
+//       writes a generated topology as a text edge list (or binary CSR)
+//   convert <in> <out> [--base b]
+//       text edge list (or CSR) -> binary CSR
+//   bench <in> [--base b]
+//       times reading <in> with istream >>, with the mapped from_chars
+//       reader, and loading its CSR form; all three must agree
+// --base is the first node number in text files: 1 (task1, task3, the
+// default) or 0 (task2).
+
+double seconds_since(chrono::steady_clock::time_point start) {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+// The way the lab programs read their input.
+bool read_with_stream(const string& path, int base, Graph& graph) {
+    ifstream in(path);
+    int N, M;
+    if (!(in >> N >> M)) return false;
+    graph = Graph(N);
+    for (int i = 0; i < M; ++i) {
+        int u, v, cost;
+        if (!(in >> u >> v >> cost)) return false;
+        graph.set_link(u - base, v - base, cost);
+    }
+    return true;
+}
+
+bool same_graph(const Graph& a, const Graph& b) {
+    if (a.size() != b.size() || a.num_edges() != b.num_edges()) return false;
+    for (int u = 0; u < a.size(); ++u) {
+        for (const Neighbor& nb : a.neighbors(u)) {
+            if (b.link_cost(u, nb.node) != nb.cost) return false;
+        }
+    }
+    return true;
+}
+
+void usage() {
+    cerr << "Usage: ./topo_tool gen <random|waxman|ba|grid|fat-tree> <size> <out> [--binary] [--base b] [--seed n]\n"
+         << "       ./topo_tool convert <in> <out> [--base b]\n"
+         << "       ./topo_tool bench <in> [--base b]\n";
+}
+
+int main(int argc, char* argv[]) {
+    vector<string> args;
+    int base = 1;
+    uint64_t seed = 1;
+    bool binary = false;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--base" && i + 1 < argc) {
+            base = stoi(argv[++i]);
+        } else if (arg == "--seed" && i + 1 < argc) {
+            seed = stoull(argv[++i]);
+        } else if (arg == "--binary") {
+            binary = true;
+        } else {
+            args.push_back(arg);
+        }
+    }
+    if (args.empty()) {
+        usage();
+        return 1;
+    }
+
+    if (args[0] == "gen" && args.size() == 4) {
+        Graph graph;
+        string error;
+        auto start = chrono::steady_clock::now();
+        if (!make_topology(args[1], stoi(args[2]), seed, graph, error)) {
+            cerr << error << "\n";
+            return 1;
+        }
+        double generated = seconds_since(start);
+        start = chrono::steady_clock::now();
+        bool ok = binary ? write_csr(args[3], graph) : write_edge_list(args[3], graph, base);
+        if (!ok) {
+            cerr << "Cannot write " << args[3] << "\n";
+            return 1;
+        }
+        cout << args[1] << ": " << graph.size() << " nodes, " << graph.num_edges() << " links; generated in "
+             << fixed << setprecision(3) << generated << " s, written in " << seconds_since(start) << " s\n";
+    } else if (args[0] == "convert" && args.size() == 3) {
+        Graph graph;
+        if (!load_topology(args[1], base, graph)) {
+            cerr << "Cannot read " << args[1] << "\n";
+            return 1;
+        }
+        if (!write_csr(args[2], graph)) {
+            cerr << "Cannot write " << args[2] << "\n";
+            return 1;
+        }
+        cout << graph.size() << " nodes, " << graph.num_edges() << " links\n";
+    } else if (args[0] == "bench" && args.size() == 2) {
+        Graph streamed, mapped;
+        auto start = chrono::steady_clock::now();
+        if (!read_with_stream(args[1], base, streamed)) {
+            cerr << "Cannot read " << args[1] << " as a text edge list\n";
+            return 1;
+        }
+        double stream_time = seconds_since(start);
+        start = chrono::steady_clock::now();
+        read_edge_list(args[1], base, mapped);
+        double mapped_time = seconds_since(start);
+
+        string csr_path = args[1] + ".csr";
+        write_csr(csr_path, mapped);
+        start = chrono::steady_clock::now();
+        CsrGraph csr(csr_path);
+        double open_time = seconds_since(start);
+        start = chrono::steady_clock::now();
+        Graph loaded = csr.to_graph();
+        double convert_time = seconds_since(start);
+
+        bool same = csr.ok() && same_graph(streamed, mapped) && same_graph(streamed, loaded);
+        cout << streamed.size() << " nodes, " << streamed.num_edges() << " links\n" << fixed << setprecision(2)
+             << "  istream >>              " << setw(9) << stream_time * 1e3 << " ms\n"
+             << "  mmap + from_chars       " << setw(9) << mapped_time * 1e3 << " ms\n"
+             << "  CSR mmap (view)         " << setw(9) << open_time * 1e3 << " ms\n"
+             << "  CSR mmap -> Graph       " << setw(9) << (open_time + convert_time) * 1e3 << " ms\n"
+             << "  same: " << (same ? "yes" : "NO") << " (CSR written to " << csr_path << ")\n";
+    } else {
+        usage();
+        return 1;
+    }
+    return 0;
+}
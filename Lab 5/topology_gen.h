@@ -0,0 +1,177 @@
+#ifndef TOPOLOGY_GEN_H
+#define TOPOLOGY_GEN_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+#include "graph.h"
+
+// Synthetic topologies for the routing benchmarks, all connected and
+// 0-based. make_random_graph (graph.h) remains the plain random graph.
+
+// Waxman: nodes at random points in the unit square, each pair linked with
+// probability beta * exp(-d / (alpha * sqrt(2))). Link cost grows with
+// length relative to that scale (1 to 10). Candidate pairs are found
+// through a grid of cells, so pairs further apart than `max_reach` (where
+// the probability is below 1e-3) are never examined. Components are then
+// chained together through their lowest-numbered nodes.
+inline Graph make_waxman_graph(int n, double alpha, double beta, uint64_t seed) {
+    std::mt19937_64 gen(seed);
+    std::uniform_real_distribution<double> unit(0, 1);
+    std::vector<double> x(n), y(n);
+    for (int v = 0; v < n; ++v) {
+        x[v] = unit(gen);
+        y[v] = unit(gen);
+    }
+    double scale = alpha * std::sqrt(2.0);
+    double max_reach = std::min(std::sqrt(2.0), scale * std::log(beta * 1e3 + 1));
+    int cells = std::max(1, std::min(1024, static_cast<int>(1 / max_reach)));
+    std::vector<std::vector<int>> grid(cells * cells);
+    auto cell_of = [&](double c) { return std::min(cells - 1, static_cast<int>(c * cells)); };
+    for (int v = 0; v < n; ++v) grid[cell_of(y[v]) * cells + cell_of(x[v])].push_back(v);
+
+    double reach2 = max_reach * max_reach;
+    auto link_cost = [&](double d) { return 1 + std::min(9, static_cast<int>(3 * d / scale)); };
+    Graph g(n);
+    for (int v = 0; v < n; ++v) {
+        int cx = cell_of(x[v]), cy = cell_of(y[v]);
+        for (int dy = -1; dy <= 1; ++dy) {
+            for (int dx = -1; dx <= 1; ++dx) {
+                int gx = cx + dx, gy = cy + dy;
+                if (gx < 0 || gy < 0 || gx >= cells || gy >= cells) continue;
+                for (int u : grid[gy * cells + gx]) {
+                    if (u <= v) continue;
+                    double ddx = x[u] - x[v], ddy = y[u] - y[v];
+                    double d2 = ddx * ddx + ddy * ddy;
+                    if (d2 > reach2) continue;
+                    double d = std::sqrt(d2);
+                    if (unit(gen) >= beta * std::exp(-d / scale)) continue;
+                    g.add_link(v, u, link_cost(d));
+                }
+            }
+        }
+    }
+
+    // Connect the components in index order.
+    std::vector<int> component(n, -1);
+    std::vector<int> stack;
+    int previous = -1;
+    for (int v = 0; v < n; ++v) {
+        if (component[v] >= 0) continue;
+        component[v] = v;
+        stack.push_back(v);
+        while (!stack.empty()) {
+            int a = stack.back();
+            stack.pop_back();
+            for (const Neighbor& nb : g.neighbors(a)) {
+                if (component[nb.node] < 0) {
+                    component[nb.node] = v;
+                    stack.push_back(nb.node);
+                }
+            }
+        }
+        if (previous >= 0) {
+            g.add_link(previous, v, link_cost(std::hypot(x[v] - x[previous], y[v] - y[previous])));
+        }
+        previous = v;
+    }
+    return g;
+}
+
+// Barabasi-Albert preferential attachment: each new node links to `m`
+// distinct existing nodes chosen with probability proportional to degree.
+// Costs uniform in [1, max_cost].
+inline Graph make_ba_graph(int n, int m, int max_cost, uint64_t seed) {
+    std::mt19937_64 gen(seed);
+    std::uniform_int_distribution<int> cost(1, max_cost);
+    Graph g(n);
+    std::vector<int> endpoints; // every node once per incident link
+    int core = std::min(n, m + 1);
+    for (int v = 0; v < core; ++v) {
+        for (int u = 0; u < v; ++u) {
+            g.add_link(u, v, cost(gen));
+            endpoints.push_back(u);
+            endpoints.push_back(v);
+        }
+    }
+    std::vector<int> chosen;
+    for (int v = core; v < n; ++v) {
+        chosen.clear();
+        while (static_cast<int>(chosen.size()) < m) {
+            int u = endpoints[gen() % endpoints.size()];
+            if (std::find(chosen.begin(), chosen.end(), u) == chosen.end()) chosen.push_back(u);
+        }
+        for (int u : chosen) {
+            g.add_link(u, v, cost(gen));
+            endpoints.push_back(u);
+            endpoints.push_back(v);
+        }
+    }
+    return g;
+}
+
+// rows x cols grid, node r * cols + c; costs uniform in [1, max_cost]
+// (max_cost 1 gives a unit-cost grid).
+inline Graph make_grid_graph(int rows, int cols, int max_cost, uint64_t seed) {
+    std::mt19937_64 gen(seed);
+    std::uniform_int_distribution<int> cost(1, max_cost);
+    Graph g(rows * cols);
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            int v = r * cols + c;
+            if (c + 1 < cols) g.add_link(v, v + 1, cost(gen));
+            if (r + 1 < rows) g.add_link(v, v + cols, cost(gen));
+        }
+    }
+    return g;
+}
+
+// k-ary fat-tree switches (k even), unit costs: (k/2)^2 core switches
+// first, then per pod k/2 aggregation and k/2 edge switches. Aggregation
+// switch i of every pod links to core switches i*k/2 .. i*k/2 + k/2 - 1;
+// every edge switch links to every aggregation switch in its pod. Hosts are
+// left out; the edge switches stand for them.
+inline Graph make_fat_tree_graph(int k) {
+    int half = k / 2;
+    int cores = half * half;
+    Graph g(cores + k * k);
+    for (int pod = 0; pod < k; ++pod) {
+        int agg0 = cores + pod * k;
+        int edge0 = agg0 + half;
+        for (int i = 0; i < half; ++i) {
+            for (int j = 0; j < half; ++j) {
+                g.add_link(agg0 + i, i * half + j, 1);
+                g.add_link(edge0 + j, agg0 + i, 1);
+            }
+        }
+    }
+    return g;
+}
+
+// Generator by name; `size` is the node count (grid: side length, fat-tree:
+// k). Waxman's alpha is scaled so the mean degree stays near 4 at any size.
+// Returns false, with the reason in `error`, for an unknown name or a size
+// the generator cannot build (an odd fat-tree k would be disconnected).
+inline bool make_topology(const std::string& kind, int size, uint64_t seed, Graph& graph, std::string& error) {
+    if (kind == "fat-tree" && (size < 2 || size % 2 != 0)) {
+        error = "fat-tree needs an even k >= 2, not " + std::to_string(size);
+        return false;
+    }
+    if (kind == "random") graph = make_random_graph(size, size + size / 2, 10, seed);
+    else if (kind == "waxman") {
+        double alpha = std::min(0.4, std::sqrt(4.0 / (size * 0.4 * 2 * M_PI)) / std::sqrt(2.0));
+        graph = make_waxman_graph(size, alpha, 0.4, seed);
+    } else if (kind == "ba") graph = make_ba_graph(size, 2, 10, seed);
+    else if (kind == "grid") graph = make_grid_graph(size, size, 10, seed);
+    else if (kind == "fat-tree") graph = make_fat_tree_graph(size);
+    else {
+        error = "Unknown topology: " + kind;
+        return false;
+    }
+    return true;
+}
+
+#endif
@@ -0,0 +1,271 @@
+#ifndef TOPOLOGY_IO_H
+#define TOPOLOGY_IO_H
+
+#include <charconv>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <iostream>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "graph.h"
+#include "topology_gen.h"
+
+// Topology files.
+//
+// Text edge lists use the lab input format: "N M" and then M lines
+// "u v cost". task2 numbers nodes from 0 and task1 / task3 from 1, so every
+// reader and writer takes the base explicitly; Graph itself is always
+// 0-based. Anything after a '#' on a line is a comment. The file is mapped
+// and parsed in place with std::from_chars, with no stream or locale
+// machinery per number.
+//
+// The binary format is a CSR dump of a Graph that loads with one mmap:
+//   header   magic "CSRG", version, node count, adjacency entry count
+//   offsets  uint64[nodes + 1], node v's neighbors are [offsets[v], offsets[v + 1])
+//   entries  Neighbor[entries] (node, cost as int32), each link in both directions
+// CsrGraph reads it in place; to_graph() copies it into a Graph.
+
+// Read-only memory mapping of a whole file.
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        struct stat st;
+        if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+            void* mapped = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped != MAP_FAILED) {
+                bytes = static_cast<const char*>(mapped);
+                length = static_cast<size_t>(st.st_size);
+                ::madvise(mapped, length, MADV_SEQUENTIAL);
+            }
+        }
+        ::close(fd);
+    }
+    ~MappedFile() {
+        if (bytes) ::munmap(const_cast<char*>(bytes), length);
+    }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool ok() const { return bytes != nullptr; }
+    const char* data() const { return bytes; }
+    size_t size() const { return length; }
+
+private:
+    const char* bytes = nullptr;
+    size_t length = 0;
+};
+
+// Cursor over an edge-list text that skips blanks and '#' comments.
+class EdgeListParser {
+public:
+    EdgeListParser(const char* begin, const char* end) : p(begin), end(end) {}
+
+    bool next(int& value) {
+        while (p < end) {
+            char c = *p;
+            if (c == '#') {
+                while (p < end && *p != '\n') ++p;
+            } else if (c == ' ' || c == '\n' || c == '\r' || c == '\t') {
+                ++p;
+            } else {
+                break;
+            }
+        }
+        std::from_chars_result r = std::from_chars(p, end, value);
+        if (r.ec != std::errc()) return false;
+        p = r.ptr;
+        return true;
+    }
+
+private:
+    const char* p;
+    const char* end;
+};
+
+// Parses "N M" and M links numbered from `base`. Repeated links keep the
+// last cost, like Graph::set_link.
+inline bool parse_edge_list(const char* begin, const char* end, int base, Graph& graph) {
+    EdgeListParser parser(begin, end);
+    int n, m;
+    if (!parser.next(n) || !parser.next(m) || n < 0 || m < 0) return false;
+    graph = Graph(n);
+    for (int i = 0; i < m; ++i) {
+        int u, v, cost;
+        if (!parser.next(u) || !parser.next(v) || !parser.next(cost)) return false;
+        u -= base;
+        v -= base;
+        if (u < 0 || u >= n || v < 0 || v >= n || u == v) return false;
+        graph.set_link(u, v, cost);
+    }
+    return true;
+}
+
+inline bool read_edge_list(const std::string& path, int base, Graph& graph) {
+    MappedFile file(path);
+    return file.ok() && parse_edge_list(file.data(), file.data() + file.size(), base, graph);
+}
+
+// Writes each link once, through a 1 MB buffer.
+inline bool write_edge_list(const std::string& path, const Graph& graph, int base) {
+    FILE* out = std::fopen(path.c_str(), "wb");
+    if (!out) return false;
+    std::vector<char> buffer(1 << 20);
+    size_t used = 0;
+    auto put = [&](long long value, char separator) {
+        if (buffer.size() - used < 32) {
+            std::fwrite(buffer.data(), 1, used, out);
+            used = 0;
+        }
+        char* p = std::to_chars(buffer.data() + used, buffer.data() + buffer.size(), value).ptr;
+        *p++ = separator;
+        used = p - buffer.data();
+    };
+    put(graph.size(), ' ');
+    put(static_cast<long long>(graph.num_edges()), '\n');
+    for (int u = 0; u < graph.size(); ++u) {
+        for (const Neighbor& nb : graph.neighbors(u)) {
+            if (u > nb.node) continue;
+            put(u + base, ' ');
+            put(nb.node + base, ' ');
+            put(nb.cost, '\n');
+        }
+    }
+    std::fwrite(buffer.data(), 1, used, out);
+    return std::fclose(out) == 0;
+}
+
+struct CsrHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t nodes;
+    uint64_t entries;
+};
+
+inline bool write_csr(const std::string& path, const Graph& graph) {
+    FILE* out = std::fopen(path.c_str(), "wb");
+    if (!out) return false;
+    CsrHeader header = {{'C', 'S', 'R', 'G'}, 1, static_cast<uint64_t>(graph.size()), 2 * graph.num_edges()};
+    std::vector<uint64_t> offsets(graph.size() + 1, 0);
+    for (int v = 0; v < graph.size(); ++v) offsets[v + 1] = offsets[v] + graph.neighbors(v).size();
+    std::fwrite(&header, sizeof(header), 1, out);
+    std::fwrite(offsets.data(), sizeof(uint64_t), offsets.size(), out);
+    for (int v = 0; v < graph.size(); ++v) {
+        std::fwrite(graph.neighbors(v).data(), sizeof(Neighbor), graph.neighbors(v).size(), out);
+    }
+    return std::fclose(out) == 0;
+}
+
+class CsrGraph {
+public:
+    explicit CsrGraph(const std::string& path) : file(path) {
+        if (!file.ok() || file.size() < sizeof(CsrHeader)) return;
+        const CsrHeader* header = reinterpret_cast<const CsrHeader*>(file.data());
+        if (std::memcmp(header->magic, "CSRG", 4) != 0 || header->version != 1) return;
+        if (header->nodes >= static_cast<uint64_t>(INT_MAX) || header->nodes >= file.size() / sizeof(uint64_t) ||
+            header->entries > file.size() / sizeof(Neighbor)) {
+            return;
+        }
+        size_t expected = sizeof(CsrHeader) + (header->nodes + 1) * sizeof(uint64_t) + header->entries * sizeof(Neighbor);
+        if (file.size() != expected) return;
+        int count = static_cast<int>(header->nodes);
+        const uint64_t* offs = reinterpret_cast<const uint64_t*>(file.data() + sizeof(CsrHeader));
+        const Neighbor* list = reinterpret_cast<const Neighbor*>(offs + count + 1);
+        // Nothing in a corrupt or foreign file may point outside the arrays.
+        if (offs[0] != 0 || offs[count] != header->entries) return;
+        for (int v = 0; v < count; ++v) {
+            if (offs[v + 1] < offs[v]) return;
+        }
+        for (uint64_t e = 0; e < header->entries; ++e) {
+            if (list[e].node < 0 || list[e].node >= count) return;
+        }
+        n = count;
+        offsets = offs;
+        entries = list;
+    }
+
+    bool ok() const { return offsets != nullptr; }
+    int size() const { return n; }
+    size_t degree(int v) const { return offsets[v + 1] - offsets[v]; }
+    const Neighbor* begin(int v) const { return entries + offsets[v]; }
+    const Neighbor* end(int v) const { return entries + offsets[v + 1]; }
+
+    Graph to_graph() const {
+        Graph graph(n);
+        for (int v = 0; v < n; ++v) graph.reserve(v, degree(v));
+        for (int v = 0; v < n; ++v) {
+            for (const Neighbor* nb = begin(v); nb != end(v); ++nb) {
+                if (v < nb->node) graph.add_link(v, nb->node, nb->cost);
+            }
+        }
+        return graph;
+    }
+
+private:
+    MappedFile file;
+    int n = 0;
+    const uint64_t* offsets = nullptr;
+    const Neighbor* entries = nullptr;
+};
+
+// Binary CSR if the file starts with its magic, otherwise a text edge list
+// numbered from `base`.
+inline bool load_topology(const std::string& path, int base, Graph& graph) {
+    CsrGraph csr(path);
+    if (csr.ok()) {
+        graph = csr.to_graph();
+        return true;
+    }
+    return read_edge_list(path, base, graph);
+}
+
+// The graph a routing tool runs on: `input` (1-based edge list or CSR) if
+// given, otherwise the `kind` generator at `nodes`. random_links >= 0 sets
+// the link count of the "random" topology instead of make_topology's.
+// Prints the problem and returns false if there is no graph.
+inline bool load_or_make_topology(const std::string& input, const std::string& kind, int nodes, uint64_t seed,
+                                  Graph& graph, int random_links = -1) {
+    if (!input.empty()) {
+        if (load_topology(input, 1, graph)) return true;
+        std::cerr << "Cannot read " << input << "\n";
+        return false;
+    }
+    if (kind == "random" && random_links >= 0) {
+        graph = make_random_graph(nodes, random_links, 10, seed);
+        return true;
+    }
+    std::string error;
+    if (make_topology(kind, nodes, seed, graph, error)) return true;
+    std::cerr << error << "\n";
+    return false;
+}
+
+// The link a tool fails, 0-based. Without --fail (`given` false) it is node
+// 1's first link, its spanning-tree link in a random graph; otherwise both
+// ends must be nodes of the graph with a link between them. Prints the
+// problem and returns false if there is no such link.
+inline bool choose_failed_link(const Graph& graph, bool given, int& u, int& v) {
+    int n = graph.size();
+    if (n < 2) {
+        std::cerr << "Need at least 2 nodes\n";
+        return false;
+    }
+    if (!given) {
+        u = 1;
+        v = graph.neighbors(1).empty() ? 0 : graph.neighbors(1)[0].node;
+    }
+    if (u < 0 || u >= n || v < 0 || v >= n || graph.link_cost(u, v) == INF) {
+        std::cerr << "No link " << u << "-" << v << "\n";
+        return false;
+    }
+    return true;
+}
+
+#endif
@@ -0,0 +1,196 @@
+#ifndef WHAT_IF_H
+#define WHAT_IF_H
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include "graph.h"
+#include "parallel_routes.h"
+#include "radix_heap.h"
+#include "work_stealing.h"
+
+// Failure what-if analysis: the impact of taking down a link, or a group of
+// links that share a risk (a conduit, a line card), on every route.
+//
+// Shortest-path trees are computed once for every source. A scenario only
+// disturbs the sources whose tree contains one of its links, and in those
+// only the subtrees hanging below the failed links; everything else keeps
+// its baseline route. For each disturbed subtree the nodes are re-attached
+// from their best neighbors outside it and Dijkstra runs over the subtree
+// alone, on the worker's own scratch, without touching the baseline. Nodes
+// left at INF become unreachable pairs; the rest are compared with their
+// baseline cost (stretch = new cost / old cost).
+//
+// Scenarios are independent and are spread over a work-stealing pool.
+
+struct FailureScenario {
+    std::string name;
+    std::vector<std::pair<int, int>> links;
+};
+
+struct FailureImpact {
+    int scenario = 0;
+    uint64_t affected_sources = 0;  // trees that used a failed link
+    uint64_t unreachable_pairs = 0; // (source, destination) pairs cut off
+    uint64_t longer_pairs = 0;      // pairs that now take a dearer path
+    uint64_t extra_cost = 0;        // summed over the longer pairs
+    double stretch_sum = 0;         // likewise
+    double max_stretch = 1;
+
+    double mean_stretch() const { return longer_pairs ? stretch_sum / longer_pairs : 1; }
+};
+
+// Worst first: more unreachable pairs, then more extra cost.
+inline bool more_severe(const FailureImpact& a, const FailureImpact& b) {
+    if (a.unreachable_pairs != b.unreachable_pairs) return a.unreachable_pairs > b.unreachable_pairs;
+    if (a.extra_cost != b.extra_cost) return a.extra_cost > b.extra_cost;
+    return a.scenario < b.scenario;
+}
+
+class WhatIfEngine {
+public:
+    // Uses every node as a source when `sources` is empty.
+    explicit WhatIfEngine(const Graph& graph, std::vector<int> sources = {})
+        : graph(graph), n(graph.size()), sources(std::move(sources)) {
+        if (this->sources.empty()) {
+            for (int v = 0; v < n; ++v) this->sources.push_back(v);
+        }
+    }
+
+    // Baseline trees for every source.
+    void build_baseline(WorkStealingPool& pool) {
+        dist.assign(sources.size() * n, INF);
+        parent.assign(sources.size() * n, -1);
+        std::vector<int> slot(n, -1);
+        for (size_t i = 0; i < sources.size(); ++i) slot[sources[i]] = static_cast<int>(i);
+        for_each_source(graph, sources, pool, [&](int, int source, const SpfScratch& s) {
+            size_t base = static_cast<size_t>(slot[source]) * n;
+            std::copy(s.dist.begin(), s.dist.end(), dist.begin() + base);
+            std::copy(s.parent.begin(), s.parent.end(), parent.begin() + base);
+        });
+    }
+
+    // Impact of every scenario, in scenario order.
+    std::vector<FailureImpact> evaluate_all(const std::vector<FailureScenario>& scenarios, WorkStealingPool& pool,
+                                            int grain = 4) const {
+        std::vector<FailureImpact> impacts(scenarios.size());
+        std::vector<Scratch> scratch(pool.size());
+        pool.parallel_for(static_cast<int>(scenarios.size()), grain, [&](int worker, int begin, int end) {
+            for (int i = begin; i < end; ++i) {
+                impacts[i] = evaluate(scenarios[i], scratch[worker]);
+                impacts[i].scenario = i;
+            }
+        });
+        return impacts;
+    }
+
+    struct Scratch {
+        std::vector<int> dist;       // new distance of affected nodes
+        std::vector<uint8_t> affected;
+        std::vector<int> subtree;
+        std::vector<std::pair<int, int>> failed; // normalized u < v
+        RadixHeap heap;
+    };
+
+    FailureImpact evaluate(const FailureScenario& scenario, Scratch& s) const {
+        if (s.dist.size() != static_cast<size_t>(n)) {
+            s.dist.assign(n, INF);
+            s.affected.assign(n, 0);
+        }
+        s.failed.clear();
+        for (const std::pair<int, int>& link : scenario.links) {
+            s.failed.push_back(std::make_pair(std::min(link.first, link.second), std::max(link.first, link.second)));
+        }
+
+        FailureImpact impact;
+        for (size_t slot = 0; slot < sources.size(); ++slot) {
+            const int* d = &dist[slot * n];
+            const int* par = &parent[slot * n];
+
+            // Roots of the cut subtrees: the lower end of each failed tree link.
+            s.subtree.clear();
+            for (const std::pair<int, int>& link : s.failed) {
+                int u = link.first, v = link.second;
+                int root = par[v] == u ? v : par[u] == v ? u : -1;
+                if (root < 0 || root == sources[slot] || s.affected[root]) continue;
+                s.affected[root] = 1;
+                s.subtree.push_back(root);
+            }
+            if (s.subtree.empty()) continue;
+            impact.affected_sources++;
+            for (size_t i = 0; i < s.subtree.size(); ++i) {
+                int p = s.subtree[i];
+                for (const Neighbor& nb : graph.neighbors(p)) {
+                    if (!s.affected[nb.node] && par[nb.node] == p) {
+                        s.affected[nb.node] = 1;
+                        s.subtree.push_back(nb.node);
+                    }
+                }
+            }
+
+            // Re-attach from outside the subtree, then finish inside it.
+            s.heap.clear();
+            for (int x : s.subtree) {
+                int best = INF;
+                for (const Neighbor& nb : graph.neighbors(x)) {
+                    if (s.affected[nb.node] || d[nb.node] == INF || is_failed(s, x, nb.node)) continue;
+                    best = std::min(best, d[nb.node] + nb.cost);
+                }
+                s.dist[x] = best;
+                if (best != INF) s.heap.push(static_cast<uint32_t>(best), x);
+            }
+            while (!s.heap.empty()) {
+                std::pair<uint32_t, int> top = s.heap.pop();
+                int x = top.second;
+                if (static_cast<int>(top.first) != s.dist[x]) continue;
+                for (const Neighbor& nb : graph.neighbors(x)) {
+                    if (!s.affected[nb.node] || is_failed(s, x, nb.node)) continue;
+                    int candidate = s.dist[x] + nb.cost;
+                    if (candidate < s.dist[nb.node]) {
+                        s.dist[nb.node] = candidate;
+                        s.heap.push(static_cast<uint32_t>(candidate), nb.node);
+                    }
+                }
+            }
+
+            for (int x : s.subtree) {
+                if (s.dist[x] == INF) {
+                    impact.unreachable_pairs++;
+                } else if (s.dist[x] > d[x]) {
+                    double stretch = double(s.dist[x]) / d[x];
+                    impact.longer_pairs++;
+                    impact.extra_cost += s.dist[x] - d[x];
+                    impact.stretch_sum += stretch;
+                    impact.max_stretch = std::max(impact.max_stretch, stretch);
+                }
+                s.affected[x] = 0;
+                s.dist[x] = INF;
+            }
+        }
+        return impact;
+    }
+
+    // Baseline distance from sources[slot].
+    int baseline_distance(size_t slot, int dest) const { return dist[slot * n + dest]; }
+    const std::vector<int>& get_sources() const { return sources; }
+    const Graph& get_graph() const { return graph; }
+
+private:
+    static bool is_failed(const Scratch& s, int u, int v) {
+        if (u > v) std::swap(u, v);
+        for (const std::pair<int, int>& link : s.failed) {
+            if (link.first == u && link.second == v) return true;
+        }
+        return false;
+    }
+
+    Graph graph;
+    int n;
+    std::vector<int> sources;
+    std::vector<int> dist;   // [slot * n + node]
+    std::vector<int> parent;
+};
+
+#endif
@@ -0,0 +1,207 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <chrono>
+#include <iomanip>
+#include <random>
+#include <algorithm>
+#include <string>
+#include <thread>
+#include "graph.h"
+#include "topology_io.h"
+#include "topology_gen.h"
+#include "parallel_routes.h"
+#include "what_if.h"
+
+using namespace std;
+
+// Failure-impact report (what_if.h): every single link, plus shared-risk
+// link groups, ranked by how many routes they cut off and then by the extra
+// cost they add.
+//
+// The topology is a random graph, one of the topology_gen.h generators with
+// --topology (--nodes is its size), or with --input a task1-style file (N M,
+// then M lines "u v cost", 1-based) or its binary CSR form (topo_tool).
+// Shared-risk groups come from --srlg, a file with one group per line written
+// as 1-based "u-v" links, and/or --random-srlgs K, which adds K groups of 2-4
+// random links.
+// --check recomputes the first scenarios from scratch and compares.
+// Usage: ./whatif [--nodes 2000] [--topology kind] [--input file]
+//                 [--sources S (0 = all)] [--srlg file] [--random-srlgs K]
+//                 [--threads T] [--top K] [--check K] [--seed n]
+
+double seconds_since(chrono::steady_clock::time_point start) {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+// One group per line. Every entry must be an existing link between nodes
+// in [1, N]; otherwise `bad` names the first entry that is not.
+bool read_srlgs(const string& path, const Graph& graph, vector<FailureScenario>& scenarios, string& bad) {
+    ifstream in(path);
+    if (!in) {
+        bad = "cannot read " + path;
+        return false;
+    }
+    string line;
+    int number = 0;
+    while (getline(in, line)) {
+        istringstream words(line);
+        FailureScenario group;
+        group.name = "srlg " + to_string(++number);
+        string link;
+        while (words >> link) {
+            istringstream item(link);
+            int u, v;
+            char dash = 0;
+            if (!(item >> u >> dash >> v) || dash != '-' || item.get() != EOF || u < 1 || u > graph.size() ||
+                v < 1 || v > graph.size() || graph.link_cost(u - 1, v - 1) == INF) {
+                bad = "no link " + link + " (line " + to_string(number) + ")";
+                return false;
+            }
+            group.links.push_back(make_pair(u - 1, v - 1));
+        }
+        if (!group.links.empty()) scenarios.push_back(group);
+    }
+    return true;
+}
+
+string link_name(int u, int v) {
+    return to_string(u + 1) + "-" + to_string(v + 1);
+}
+
+int main(int argc, char* argv[]) {
+    int nodes = 2000;
+    string topology = "random";
+    string input, srlg_file;
+    int sampled = 0;
+    int random_srlgs = 0;
+    int threads = static_cast<int>(thread::hardware_concurrency());
+    int top = 15;
+    int check = 0;
+    uint64_t seed = 1;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--nodes" && i + 1 < argc) {
+            nodes = stoi(argv[++i]);
+        } else if (arg == "--topology" && i + 1 < argc) {
+            topology = argv[++i];
+        } else if (arg == "--input" && i + 1 < argc) {
+            input = argv[++i];
+        } else if (arg == "--sources" && i + 1 < argc) {
+            sampled = stoi(argv[++i]);
+        } else if (arg == "--srlg" && i + 1 < argc) {
+            srlg_file = argv[++i];
+        } else if (arg == "--random-srlgs" && i + 1 < argc) {
+            random_srlgs = stoi(argv[++i]);
+        } else if (arg == "--threads" && i + 1 < argc) {
+            threads = stoi(argv[++i]);
+        } else if (arg == "--top" && i + 1 < argc) {
+            top = stoi(argv[++i]);
+        } else if (arg == "--check" && i + 1 < argc) {
+            check = stoi(argv[++i]);
+        } else if (arg == "--seed" && i + 1 < argc) {
+            seed = stoull(argv[++i]);
+        } else {
+            cerr << "Unknown argument: " << arg << "\n";
+            return 1;
+        }
+    }
+
+    Graph graph;
+    if (!load_or_make_topology(input, topology, nodes, seed, graph, nodes / 2)) return 1;
+    int N = graph.size();
+    mt19937_64 gen(seed);
+
+    vector<int> sources;
+    if (sampled > 0 && sampled < N) {
+        for (int i = 0; i < sampled; ++i) sources.push_back(static_cast<int>(gen() % N));
+        sort(sources.begin(), sources.end());
+        sources.erase(unique(sources.begin(), sources.end()), sources.end());
+    }
+
+    // Every single link, then the shared-risk groups.
+    vector<FailureScenario> scenarios;
+    vector<pair<int, int>> links;
+    for (int u = 0; u < N; ++u) {
+        for (const Neighbor& nb : graph.neighbors(u)) {
+            if (u < nb.node) links.push_back(make_pair(u, nb.node));
+        }
+    }
+    for (const pair<int, int>& link : links) {
+        scenarios.push_back(FailureScenario{"link " + link_name(link.first, link.second), {link}});
+    }
+    string bad;
+    if (!srlg_file.empty() && !read_srlgs(srlg_file, graph, scenarios, bad)) {
+        cerr << srlg_file << ": " << bad << "\n";
+        return 1;
+    }
+    for (int g = 0; g < random_srlgs && !links.empty(); ++g) {
+        FailureScenario group;
+        group.name = "random srlg " + to_string(g + 1) + ":";
+        int size = 2 + static_cast<int>(gen() % 3);
+        for (int k = 0; k < size; ++k) {
+            const pair<int, int>& link = links[gen() % links.size()];
+            group.links.push_back(link);
+            group.name += " " + link_name(link.first, link.second);
+        }
+        scenarios.push_back(group);
+    }
+
+    WorkStealingPool pool(threads);
+    WhatIfEngine engine(graph, sources);
+    auto start = chrono::steady_clock::now();
+    engine.build_baseline(pool);
+    double baseline = seconds_since(start);
+
+    start = chrono::steady_clock::now();
+    vector<FailureImpact> impacts = engine.evaluate_all(scenarios, pool);
+    double elapsed = seconds_since(start);
+
+    size_t num_sources = engine.get_sources().size();
+    cout << N << " nodes, " << graph.num_edges() << " links, " << num_sources << " sources, " << pool.size()
+         << " threads\n";
+    cout << scenarios.size() << " scenarios in " << fixed << setprecision(3) << elapsed << " s ("
+         << setprecision(0) << scenarios.size() / elapsed << " /s); baseline trees " << setprecision(3) << baseline
+         << " s; rebuilding per scenario would take ~" << setprecision(1) << baseline * scenarios.size() << " s\n\n";
+
+    vector<FailureImpact> ranked = impacts;
+    sort(ranked.begin(), ranked.end(), more_severe);
+    cout << "  rank   unreachable   longer    extra cost   mean stretch   max stretch   trees hit   scenario\n";
+    for (int r = 0; r < top && r < static_cast<int>(ranked.size()); ++r) {
+        const FailureImpact& impact = ranked[r];
+        cout << setw(6) << r + 1 << setw(14) << impact.unreachable_pairs << setw(9) << impact.longer_pairs
+             << setw(14) << impact.extra_cost << setprecision(3) << setw(15) << impact.mean_stretch() << setw(14)
+             << impact.max_stretch << setw(12) << impact.affected_sources << "   " << scenarios[impact.scenario].name
+             << "\n";
+    }
+
+    // Recompute the first scenarios from scratch on a copy of the graph.
+    if (check > 0) {
+        bool same = true;
+        SpfScratch scratch;
+        for (int i = 0; i < check && i < static_cast<int>(scenarios.size()); ++i) {
+            Graph failed = graph;
+            for (const pair<int, int>& link : scenarios[i].links) failed.remove_link(link.first, link.second);
+            FailureImpact expected;
+            for (size_t slot = 0; slot < num_sources; ++slot) {
+                shortest_paths(failed, engine.get_sources()[slot], scratch);
+                for (int v = 0; v < N; ++v) {
+                    int before = engine.baseline_distance(slot, v);
+                    int after = scratch.dist[v];
+                    if (after == INF && before != INF) expected.unreachable_pairs++;
+                    else if (after > before) {
+                        expected.longer_pairs++;
+                        expected.extra_cost += after - before;
+                    }
+                }
+            }
+            if (expected.unreachable_pairs != impacts[i].unreachable_pairs ||
+                expected.longer_pairs != impacts[i].longer_pairs || expected.extra_cost != impacts[i].extra_cost) {
+                same = false;
+            }
+        }
+        cout << "\nFirst " << check << " scenarios match a full recomputation: " << (same ? "yes" : "NO") << "\n";
+    }
+    return 0;
+}
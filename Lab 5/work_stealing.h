@@ -0,0 +1,97 @@
+#ifndef WORK_STEALING_H
+#define WORK_STEALING_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing parallel loop over an index range.
+//
+// The range is split evenly between the workers up front. Each worker takes
+// `grain` indices at a time from the front of its own share; a worker whose
+// share is empty steals the back half of another worker's share and carries
+// on. Shares only ever shrink, so once a full pass over the other workers
+// finds nothing left the loop is done. Each share has its own lock, which is
+// taken once per grain, so contention is negligible next to the work.
+//
+// Threads are started per call and the caller runs as worker 0.
+
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(int threads) : num_threads(std::max(1, threads)) {}
+
+    int size() const { return num_threads; }
+
+    // Calls body(worker, begin, end) on disjoint chunks covering [0, count).
+    template <class Body>
+    void parallel_for(int count, int grain, Body body) {
+        grain = std::max(1, grain);
+        std::unique_ptr<Share[]> shares(new Share[num_threads]);
+        for (int w = 0; w < num_threads; ++w) {
+            shares[w].begin = static_cast<int>(static_cast<int64_t>(count) * w / num_threads);
+            shares[w].end = static_cast<int>(static_cast<int64_t>(count) * (w + 1) / num_threads);
+        }
+        auto work = [&](int w) {
+            int begin, end;
+            while (true) {
+                if (take(shares[w], grain, begin, end)) {
+                    body(w, begin, end);
+                } else if (!steal(shares.get(), w)) {
+                    return;
+                }
+            }
+        };
+        std::vector<std::thread> workers;
+        for (int w = 1; w < num_threads; ++w) workers.emplace_back(work, w);
+        work(0);
+        for (std::thread& t : workers) t.join();
+    }
+
+    std::atomic<uint64_t> steals{0};
+
+private:
+    struct alignas(64) Share {
+        std::mutex lock;
+        int begin = 0;
+        int end = 0;
+    };
+
+    static bool take(Share& share, int grain, int& begin, int& end) {
+        std::lock_guard<std::mutex> guard(share.lock);
+        if (share.begin >= share.end) return false;
+        begin = share.begin;
+        end = std::min(share.begin + grain, share.end);
+        share.begin = end;
+        return true;
+    }
+
+    // Moves the back half of some other worker's share into worker w's.
+    bool steal(Share* shares, int w) {
+        for (int i = 1; i < num_threads; ++i) {
+            Share& victim = shares[(w + i) % num_threads];
+            int begin, end;
+            {
+                std::lock_guard<std::mutex> guard(victim.lock);
+                int left = victim.end - victim.begin;
+                if (left <= 0) continue;
+                begin = victim.begin + left / 2;
+                end = victim.end;
+                victim.end = begin;
+            }
+            std::lock_guard<std::mutex> guard(shares[w].lock);
+            shares[w].begin = begin;
+            shares[w].end = end;
+            steals++;
+            return true;
+        }
+        return false;
+    }
+
+    int num_threads;
+};
+
+#endif
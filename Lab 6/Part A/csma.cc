@@ -3,9 +3,10 @@
 #include "ns3/csma-module.h"
 #include "ns3/internet-module.h"
 #include "ns3/applications-module.h"
-#include "ns3/flow-monitor-module.h"
+#include <algorithm>
 #include <fstream>
 #include <string>
+#include <vector>
 
 using namespace ns3;
 
@@ -14,61 +15,201 @@ NS_LOG_COMPONENT_DEFINE("CsmaCdSimulation");
 // Global variables for data collection
 std::map<std::string, std::ofstream> outputFiles;
 Time binInterval = Seconds(0.1);
-uint32_t totalCollisions = 0;
-Time lastCollisionTime = Seconds(0);
-Time collisionDebounceTime = MicroSeconds(100);
 
-void CollisionCallback(std::string context, Ptr<const Packet> packet) {
+// MAC contention, per device. A CsmaNetDevice senses the channel before
+// sending and backs off while it is busy (MacTxBackoff); the channel state is
+// shared by all devices, so frames never overlap on the wire and these
+// busy-channel deferrals are the "collisions" of this model. Every one is
+// counted, on the device that deferred, along with the frames that made it
+// onto the channel and the ones given up on.
+enum MacEvent : uint8_t {
+    MAC_ENQUEUE = 0,    // MacTx: packet handed to the device
+    MAC_BACKOFF = 1,    // MacTxBackoff: channel busy, retry later
+    MAC_TX_BEGIN = 2,   // PhyTxBegin: frame goes onto the channel
+    MAC_TX_END = 3,     // PhyTxEnd
+    MAC_TX_ABORT = 4,   // PhyTxDrop: backoff retries exhausted
+    MAC_QUEUE_DROP = 5, // MacTxDrop: device queue full
+};
+
+struct DeviceCounters {
+    uint64_t enqueued = 0;
+    uint64_t backoffs = 0;
+    uint64_t transmissions = 0;
+    uint64_t aborted = 0;
+    uint64_t queueDrops = 0;
+    uint64_t deferredFrames = 0; // frames sent after at least one backoff
+    uint32_t attempt = 0;        // backoffs so far for the frame being sent
+    uint32_t maxAttempt = 0;
+    uint64_t backoffUid = 0;     // the frame `attempt` counts for
+    Time txStart;
+    int64_t busyTime = 0;        // ns on the channel
+};
+
+// One record of mac_trace.bin (--macTrace), after a 16-byte header
+// "MACT", version, devices, record size (uint32 each, little endian).
+// attempt is the backoff number for MAC_BACKOFF and the backoffs the frame
+// needed for MAC_TX_BEGIN / MAC_TX_ABORT; after its n-th backoff a device
+// waits a random 1 .. 2^min(n, 10) - 1 slots, which the trace does not
+// expose. The offline summary is mac_summary.py.
+struct MacTraceRecord {
+    int64_t time; // ns
+    uint16_t device;
+    uint8_t event;
+    uint8_t attempt; // saturates at 255
+    uint32_t packet; // low 32 bits of the packet uid
+};
+
+std::vector<DeviceCounters> deviceCounters;
+uint64_t totalBackoffs = 0;
+std::ofstream macTrace;
+
+void MacTrace(uint32_t device, MacEvent event, Ptr<const Packet> packet) {
+    DeviceCounters &c = deviceCounters[device];
     Time now = Simulator::Now();
-    if (now - lastCollisionTime >= collisionDebounceTime) {
-        totalCollisions++;
-        lastCollisionTime = now;
-        outputFiles["collisions"] << now.GetSeconds() << " " << totalCollisions << std::endl;
+    bool sameFrame = c.attempt > 0 && packet->GetUid() == c.backoffUid;
+    uint32_t attempt = 0;
+    switch (event) {
+    case MAC_ENQUEUE:
+        c.enqueued++;
+        break;
+    case MAC_BACKOFF:
+        if (!sameFrame) {
+            c.attempt = 0;
+            c.backoffUid = packet->GetUid();
+        }
+        attempt = ++c.attempt;
+        c.maxAttempt = std::max(c.maxAttempt, attempt);
+        c.backoffs++;
+        totalBackoffs++;
+        break;
+    case MAC_TX_BEGIN:
+        attempt = sameFrame ? c.attempt : 0;
+        c.deferredFrames += attempt > 0;
+        c.attempt = 0;
+        c.transmissions++;
+        c.txStart = now;
+        break;
+    case MAC_TX_END:
+        c.busyTime += (now - c.txStart).GetNanoSeconds();
+        break;
+    case MAC_TX_ABORT:
+        attempt = sameFrame ? c.attempt : 0;
+        c.attempt = 0;
+        c.aborted++;
+        break;
+    case MAC_QUEUE_DROP:
+        c.queueDrops++;
+        break;
+    }
+    if (macTrace.is_open()) {
+        MacTraceRecord record;
+        record.time = now.GetNanoSeconds();
+        record.device = device;
+        record.event = event;
+        record.attempt = std::min<uint32_t>(attempt, 255);
+        record.packet = static_cast<uint32_t>(packet->GetUid());
+        macTrace.write(reinterpret_cast<const char *>(&record), sizeof(record));
     }
 }
 
-void CollectStatistics(Ptr<FlowMonitor> flowMonitor, Ptr<NetDevice> device) {
-    static std::map<uint32_t, uint64_t> lastTxBytes;
-    static std::map<uint32_t, uint64_t> lastRxBytes;
+// Per-flow counters, updated by the applications' trace sources as packets
+// are sent and received. Flow i -> j is flows[FlowIndex(i, j)]; everything is
+// allocated before the simulation starts, so a packet costs a few additions
+// and a statistics bin costs the same however many flows there are.
+struct FlowCounters {
+    uint64_t txPackets = 0;
+    uint64_t txBytes = 0;
+    uint64_t rxPackets = 0;
+    uint64_t rxBytes = 0;
+    int64_t delaySum = 0; // ns
+    Time firstTx;
+    Time lastRx;
+};
+
+// Sums over all flows, for the whole run and for the current bin
+struct TrafficTotals {
+    uint64_t txPackets = 0;
+    uint64_t txBytes = 0;
+    uint64_t rxPackets = 0;
+    uint64_t rxBytes = 0;
+    int64_t delaySum = 0;    // ns
+    double latencySum = 0;   // s, sum over flows of last Rx - first Tx
+};
+
+std::vector<FlowCounters> flows;
+TrafficTotals runTotals;
+TrafficTotals binTotals;
+uint32_t flowNodes = 0;
+Ipv4Address firstAddress; // node i has firstAddress + i
+
+uint32_t FlowIndex(uint32_t src, uint32_t dst) {
+    return src * (flowNodes - 1) + (dst < src ? dst : dst - 1);
+}
+
+void TxTrace(uint32_t flow, Ptr<const Packet> packet, const Address &from, const Address &to,
+             const SeqTsSizeHeader &header) {
+    FlowCounters &f = flows[flow];
+    uint64_t size = header.GetSize(); // whole application packet, header included
+    if (f.txPackets == 0) {
+        f.firstTx = Simulator::Now();
+    }
+    f.txPackets++;
+    f.txBytes += size;
+    for (TrafficTotals *t : {&runTotals, &binTotals}) {
+        t->txPackets++;
+        t->txBytes += size;
+    }
+}
 
+void RxTrace(uint32_t dst, Ptr<const Packet> packet, const Address &from, const Address &to,
+             const SeqTsSizeHeader &header) {
+    uint32_t src = InetSocketAddress::ConvertFrom(from).GetIpv4().Get() - firstAddress.Get();
+    FlowCounters &f = flows[FlowIndex(src, dst)];
     Time now = Simulator::Now();
-    std::map<FlowId, FlowMonitor::FlowStats> stats = flowMonitor->GetFlowStats();
-
-    uint64_t totalTxBytes = 0;
-    uint64_t totalRxBytes = 0;
-    double totalDelay = 0;
-    double totalLatency = 0;
-    uint32_t totalPackets = 0;
-    
-    for (auto &stat : stats) {
-        totalTxBytes += stat.second.txBytes;
-        totalRxBytes += stat.second.rxBytes;
-        totalDelay += stat.second.delaySum.GetSeconds();
-        double latency = stat.second.timeLastRxPacket.GetSeconds() - stat.second.timeFirstTxPacket.GetSeconds();
-        if (latency >= 0) {
-            totalLatency += latency;
-        }
-        totalPackets += stat.second.rxPackets;
+    uint64_t size = header.GetSize(); // whole application packet, header included
+    int64_t delay = (now - header.GetTs()).GetNanoSeconds();
+    // Keeps latencySum equal to the sum of (last Rx - first Tx) over flows
+    double latencyStep = (now - (f.rxPackets == 0 ? f.firstTx : f.lastRx)).GetSeconds();
+    f.rxPackets++;
+    f.rxBytes += size;
+    f.delaySum += delay;
+    f.lastRx = now;
+    for (TrafficTotals *t : {&runTotals, &binTotals}) {
+        t->rxPackets++;
+        t->rxBytes += size;
+        t->delaySum += delay;
+        t->latencySum += latencyStep;
     }
+}
+
+// Writes the bin that just ended and starts the next one
+void CollectStatistics() {
+    Time now = Simulator::Now();
+    const TrafficTotals &run = runTotals;
+    const TrafficTotals &bin = binTotals;
 
-    // Calculate metrics
-    double throughput = (totalRxBytes - lastRxBytes[0]) * 8.0 / binInterval.GetSeconds();
-    double packetLoss = ((totalTxBytes - totalRxBytes) * 100.0) / (totalTxBytes > 0 ? totalTxBytes : 1);
-    double avgDelay = totalPackets > 0 ? (totalDelay / totalPackets) * 1000 : 0; // in ms
-    double avgLatency = totalPackets > 0 ? (totalLatency / totalPackets) * 1000 : 0; // in ms
+    // Throughput over this bin; loss, delay and latency since the start
+    double throughput = bin.rxBytes * 8.0 / binInterval.GetSeconds();
+    double packetLoss = ((run.txBytes - run.rxBytes) * 100.0) / (run.txBytes > 0 ? run.txBytes : 1);
+    double avgDelay = run.rxPackets > 0 ? (run.delaySum * 1e-9 / run.rxPackets) * 1000 : 0; // in ms
+    double avgLatency = run.rxPackets > 0 ? (run.latencySum / run.rxPackets) * 1000 : 0; // in ms
+    double binDelay = bin.rxPackets > 0 ? (bin.delaySum * 1e-9 / bin.rxPackets) * 1000 : 0; // in ms
 
     // Write metrics to files
-    outputFiles["throughput"] << now.GetSeconds() << " " << throughput / 1000000.0 << std::endl; // Mbps
-    outputFiles["packet_loss"] << now.GetSeconds() << " " << packetLoss << std::endl; // %
-    outputFiles["delay"] << now.GetSeconds() << " " << avgDelay << std::endl; // ms
-    outputFiles["latency"] << now.GetSeconds() << " " << avgLatency << std::endl; // ms
-
-    // Update last values
-    lastTxBytes[0] = totalTxBytes;
-    lastRxBytes[0] = totalRxBytes;
+    outputFiles["throughput"] << now.GetSeconds() << " " << throughput / 1000000.0 << "\n"; // Mbps
+    outputFiles["packet_loss"] << now.GetSeconds() << " " << packetLoss << "\n"; // %
+    outputFiles["delay"] << now.GetSeconds() << " " << avgDelay << "\n"; // ms
+    outputFiles["latency"] << now.GetSeconds() << " " << avgLatency << "\n"; // ms
+    // This bin only: packets and bytes sent and received, mean delay (ms)
+    outputFiles["bins"] << now.GetSeconds() << " " << bin.txPackets << " " << bin.rxPackets << " "
+                        << bin.txBytes << " " << bin.rxBytes << " " << binDelay << "\n";
+    // Backoffs so far, all devices
+    outputFiles["collisions"] << now.GetSeconds() << " " << totalBackoffs << "\n";
+
+    binTotals = TrafficTotals();
 
     // Schedule next collection
-    Simulator::Schedule(binInterval, &CollectStatistics, flowMonitor, device);
+    Simulator::Schedule(binInterval, &CollectStatistics);
 }
 
 int main(int argc, char *argv[]) {
@@ -77,6 +218,9 @@ int main(int argc, char *argv[]) {
     uint32_t dataRate = 25; // Mbps
     uint32_t packetSize = 1460;
     double channelDataRate = 100.0; // Mbps
+    std::string outDir = ".";
+    uint32_t runNumber = 1;
+    bool writeMacTrace = false;
 
     // Custom command-line parsing
     for (int i = 1; i < argc; ++i) {
@@ -89,15 +233,27 @@ int main(int argc, char *argv[]) {
             dataRate = std::stoi(argv[++i]);
         } else if (arg == "--packetSize" && i + 1 < argc) {
             packetSize = std::stoi(argv[++i]);
+        } else if (arg == "--outDir" && i + 1 < argc) {
+            outDir = argv[++i];
+        } else if (arg == "--runNumber" && i + 1 < argc) {
+            runNumber = std::stoi(argv[++i]);
+        } else if (arg == "--macTrace") {
+            writeMacTrace = true;
         }
     }
 
-    // Create output files
-    outputFiles["throughput"].open("throughput.dat");
-    outputFiles["packet_loss"].open("packet_loss.dat");
-    outputFiles["delay"].open("delay.dat");
-    outputFiles["latency"].open("latency.dat");
-    outputFiles["collisions"].open("collisions.dat");
+    // Independent random streams per run number (sweep.py gives every run
+    // its own), so repeated runs of one configuration are real replications
+    RngSeedManager::SetRun(runNumber);
+
+    // Create output files in this run's own directory
+    SystemPath::MakeDirectories(outDir);
+    outputFiles["throughput"].open(outDir + "/throughput.dat");
+    outputFiles["packet_loss"].open(outDir + "/packet_loss.dat");
+    outputFiles["delay"].open(outDir + "/delay.dat");
+    outputFiles["latency"].open(outDir + "/latency.dat");
+    outputFiles["collisions"].open(outDir + "/collisions.dat");
+    outputFiles["bins"].open(outDir + "/bins.dat");
 
     // Enable logging
     LogComponentEnable("CsmaCdSimulation", LOG_LEVEL_INFO);
@@ -114,8 +270,22 @@ int main(int argc, char *argv[]) {
     // Create devices
     NetDeviceContainer devices = csma.Install(nodes);
 
-    // Connect collision detection
-    Config::Connect("/NodeList/*/DeviceList/*/$ns3::CsmaNetDevice/MacTxBackoff", MakeCallback(&CollisionCallback));
+    // Per-device MAC counters and, with --macTrace, the binary event trace
+    deviceCounters.assign(devices.GetN(), DeviceCounters());
+    if (writeMacTrace) {
+        macTrace.open(outDir + "/mac_trace.bin", std::ios::binary);
+        uint32_t header[4] = {0x5443414d, 1, devices.GetN(), sizeof(MacTraceRecord)}; // "MACT"
+        macTrace.write(reinterpret_cast<const char *>(header), sizeof(header));
+    }
+    const std::pair<const char *, MacEvent> macSources[] = {
+        {"MacTx", MAC_ENQUEUE},         {"MacTxBackoff", MAC_BACKOFF}, {"PhyTxBegin", MAC_TX_BEGIN},
+        {"PhyTxEnd", MAC_TX_END},       {"PhyTxDrop", MAC_TX_ABORT},   {"MacTxDrop", MAC_QUEUE_DROP},
+    };
+    for (uint32_t d = 0; d < devices.GetN(); d++) {
+        for (const auto &source : macSources) {
+            devices.Get(d)->TraceConnectWithoutContext(source.first, MakeBoundCallback(&MacTrace, d, source.second));
+        }
+    }
 
     // Install Internet stack
     InternetStackHelper internet;
@@ -131,6 +301,7 @@ int main(int argc, char *argv[]) {
 
     // Install packet sinks
     PacketSinkHelper sink("ns3::UdpSocketFactory", InetSocketAddress(Ipv4Address::GetAny(), port));
+    sink.SetAttribute("EnableSeqTsSizeHeader", BooleanValue(true));
     ApplicationContainer sinkApps = sink.Install(nodes);
     sinkApps.Start(Seconds(0.0));
     sinkApps.Stop(Seconds(simTime));
@@ -141,13 +312,26 @@ int main(int argc, char *argv[]) {
     onoff.SetAttribute("OffTime", StringValue("ns3::ConstantRandomVariable[Constant=0.0]"));
     onoff.SetAttribute("DataRate", DataRateValue(DataRate(dataRate * 1000000)));
     onoff.SetAttribute("PacketSize", UintegerValue(packetSize));
+    // Sequence number and send time in every packet, for the Rx trace
+    onoff.SetAttribute("EnableSeqTsSizeHeader", BooleanValue(true));
+
+    // Per-flow counters and the trace sources that update them
+    flowNodes = nodes.GetN();
+    flows.assign(flowNodes * (flowNodes - 1), FlowCounters());
+    firstAddress = interfaces.GetAddress(0);
+    for (uint32_t j = 0; j < nodes.GetN(); j++) {
+        sinkApps.Get(j)->TraceConnectWithoutContext("RxWithSeqTsSize", MakeBoundCallback(&RxTrace, j));
+    }
 
     ApplicationContainer apps;
     for (uint32_t i = 0; i < nodes.GetN(); i++) {
         for (uint32_t j = 0; j < nodes.GetN(); j++) {
             if (i != j) {
                 onoff.SetAttribute("Remote", AddressValue(InetSocketAddress(interfaces.GetAddress(j), port)));
-                apps.Add(onoff.Install(nodes.Get(i)));
+                ApplicationContainer app = onoff.Install(nodes.Get(i));
+                app.Get(0)->TraceConnectWithoutContext("TxWithSeqTsSize",
+                                                       MakeBoundCallback(&TxTrace, FlowIndex(i, j)));
+                apps.Add(app);
             }
         }
     }
@@ -155,25 +339,80 @@ int main(int argc, char *argv[]) {
     apps.Start(Seconds(1.0));
     apps.Stop(Seconds(simTime));
 
-    // Install FlowMonitor
-    FlowMonitorHelper flowmon;
-    Ptr<FlowMonitor> monitor = flowmon.InstallAll();
-
     // Schedule statistics collection
-    Simulator::Schedule(Seconds(0.0), &CollectStatistics, monitor, devices.Get(0));
+    Simulator::Schedule(Seconds(0.0), &CollectStatistics);
 
     // Run simulation
     Simulator::Stop(Seconds(simTime));
     Simulator::Run();
 
     // Print final statistics
-    monitor->CheckForLostPackets();
-    std::map<FlowId, FlowMonitor::FlowStats> stats = monitor->GetFlowStats();
-
     std::cout << "\n=== Simulation Summary ===\n";
-    std::cout << "Total Collisions: " << totalCollisions << "\n";
-    std::cout << "Average Collision Rate: " << (totalCollisions * 1.0 / simTime)
-              << " collisions/s\n\n";
+    uint64_t transmissions = 0, aborted = 0, queueDrops = 0;
+    int64_t busyTime = 0;
+    for (const DeviceCounters &c : deviceCounters) {
+        transmissions += c.transmissions;
+        aborted += c.aborted;
+        queueDrops += c.queueDrops;
+        busyTime += c.busyTime;
+    }
+    double channelBusy = busyTime * 1e-9 * 100.0 / simTime;
+    std::cout << "Total Backoffs (busy-channel deferrals): " << totalBackoffs << "\n";
+    std::cout << "Average Backoff Rate: " << (totalBackoffs * 1.0 / simTime) << " backoffs/s\n";
+    std::cout << "Backoffs per Frame Sent: " << (transmissions > 0 ? totalBackoffs * 1.0 / transmissions : 0)
+              << "\n";
+    std::cout << "Frames Aborted: " << aborted << ", Queue Drops: " << queueDrops << "\n";
+    std::cout << "Channel Busy: " << channelBusy << "%\n\n";
+
+    // Per-device MAC totals: device enqueued backoffs transmissions
+    // deferredFrames aborted queueDrops maxAttempt busy (% of simTime)
+    std::ofstream deviceFile(outDir + "/devices.dat");
+    for (uint32_t d = 0; d < deviceCounters.size(); d++) {
+        const DeviceCounters &c = deviceCounters[d];
+        deviceFile << d << " " << c.enqueued << " " << c.backoffs << " " << c.transmissions << " "
+                   << c.deferredFrames << " " << c.aborted << " " << c.queueDrops << " " << c.maxAttempt << " "
+                   << c.busyTime * 1e-9 * 100.0 / simTime << "\n";
+    }
+    deviceFile.close();
+    macTrace.close();
+
+    // Per-flow totals: src dst txPackets rxPackets txBytes rxBytes meanDelay (ms)
+    std::ofstream flowFile(outDir + "/flows.dat");
+    for (uint32_t i = 0; i < flowNodes; i++) {
+        for (uint32_t j = 0; j < flowNodes; j++) {
+            if (i != j) {
+                const FlowCounters &f = flows[FlowIndex(i, j)];
+                flowFile << i << " " << j << " " << f.txPackets << " " << f.rxPackets << " " << f.txBytes << " "
+                         << f.rxBytes << " " << (f.rxPackets > 0 ? f.delaySum * 1e-6 / f.rxPackets : 0) << "\n";
+            }
+        }
+    }
+    flowFile.close();
+
+    // Whole-run metrics, one "name value" per line, collected by sweep.py
+    uint64_t txBytes = runTotals.txBytes;
+    uint64_t rxBytes = runTotals.rxBytes;
+    uint64_t txPackets = runTotals.txPackets;
+    uint64_t rxPackets = runTotals.rxPackets;
+    double delaySum = runTotals.delaySum * 1e-9;
+    double activeTime = simTime > 1 ? simTime - 1.0 : 1.0; // applications start at 1 s
+    std::ofstream summary(outDir + "/summary.dat");
+    summary << "nNodes " << nNodes << "\n"
+            << "dataRate " << dataRate << "\n"
+            << "packetSize " << packetSize << "\n"
+            << "simTime " << simTime << "\n"
+            << "runNumber " << runNumber << "\n"
+            << "throughput_mbps " << rxBytes * 8.0 / activeTime / 1000000.0 << "\n"
+            << "offered_mbps " << txBytes * 8.0 / activeTime / 1000000.0 << "\n"
+            << "packet_loss_pct " << (txPackets > 0 ? (txPackets - rxPackets) * 100.0 / txPackets : 0) << "\n"
+            << "delay_ms " << (rxPackets > 0 ? delaySum / rxPackets * 1000 : 0) << "\n"
+            << "backoffs " << totalBackoffs << "\n"
+            << "backoff_rate " << totalBackoffs * 1.0 / simTime << "\n"
+            << "backoffs_per_frame " << (transmissions > 0 ? totalBackoffs * 1.0 / transmissions : 0) << "\n"
+            << "aborted " << aborted << "\n"
+            << "queue_drops " << queueDrops << "\n"
+            << "channel_busy_pct " << channelBusy << "\n";
+    summary.close();
 
     // Close output files
     for (auto &file : outputFiles) {
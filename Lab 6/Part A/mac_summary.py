@@ -0,0 +1,99 @@
+import os
+import sys
+import numpy as np
+
+# Offline summary of the MAC event trace csma writes with --macTrace
+# (mac_trace.bin; record layout in csma.cc, MacTraceRecord):
+#  - where the channel time went: frames on the channel, idle while some
+#    device waits out a backoff (the contention loss), idle with nothing
+#    waiting to be sent;
+#  - per device: backoffs, frames sent, how many needed a backoff, aborts,
+#    queue drops, channel share and the mean MAC delay (handed to the
+#    device -> onto the channel, queueing included);
+#  - how many backoffs the frames needed.
+# Usage: python3 mac_summary.py [run directory or mac_trace.bin]
+
+MAC_ENQUEUE, MAC_BACKOFF, MAC_TX_BEGIN, MAC_TX_END, MAC_TX_ABORT, MAC_QUEUE_DROP = range(6)
+
+RECORD = np.dtype([('time', '<i8'), ('device', '<u2'), ('event', 'u1'), ('attempt', 'u1'), ('packet', '<u4')])
+
+def read_trace(path):
+    with open(path, 'rb') as f:
+        header = np.frombuffer(f.read(16), dtype='<u4')
+        if len(header) < 4 or header[0] != 0x5443414d or header[1] != 1 or header[3] != RECORD.itemsize:
+            sys.exit('%s: not a version 1 MAC trace' % path)
+        return int(header[2]), np.fromfile(f, dtype=RECORD)
+
+def channel_time(trace):
+    # Frames on the channel and devices in backoff after each event; a
+    # device waits from its first backoff for a frame until that frame is
+    # sent or aborted.
+    event, attempt = trace['event'], trace['attempt']
+    busy = np.cumsum((event == MAC_TX_BEGIN).astype(np.int64) - (event == MAC_TX_END))
+    waiting = np.cumsum(((event == MAC_BACKOFF) & (attempt == 1)).astype(np.int64)
+                        - (((event == MAC_TX_BEGIN) | (event == MAC_TX_ABORT)) & (attempt > 0)))
+    dt = np.diff(trace['time'])
+    busy, waiting = busy[:-1], waiting[:-1]
+    return (dt[busy > 0].sum(), dt[(busy == 0) & (waiting > 0)].sum(), dt[(busy == 0) & (waiting == 0)].sum(),
+            dt.sum())
+
+def mac_delay(trace, device):
+    # Mean time from MAC_ENQUEUE to MAC_TX_BEGIN of the same packet (ms)
+    mine = trace[trace['device'] == device]
+    enqueued = mine[mine['event'] == MAC_ENQUEUE]
+    sent = mine[mine['event'] == MAC_TX_BEGIN]
+    order = np.argsort(enqueued['packet'], kind='stable')
+    keys, times = enqueued['packet'][order], enqueued['time'][order]
+    at = np.minimum(np.searchsorted(keys, sent['packet']), max(len(keys) - 1, 0))
+    if len(keys) == 0:
+        return float('nan')
+    found = keys[at] == sent['packet']
+    if not found.any():
+        return float('nan')
+    return (sent['time'][found] - times[at][found]).mean() * 1e-6
+
+def main():
+    path = sys.argv[1] if len(sys.argv) > 1 else '.'
+    if os.path.isdir(path):
+        path = os.path.join(path, 'mac_trace.bin')
+    devices, trace = read_trace(path)
+    if len(trace) < 2:
+        print('%s: %d events' % (path, len(trace)))
+        return 0
+    event = trace['event']
+    print('%s: %d devices, %d events, %.3f s - %.3f s' % (path, devices, len(trace), trace['time'][0] * 1e-9,
+                                                          trace['time'][-1] * 1e-9))
+
+    busy, contention, idle, span = channel_time(trace)
+    print('\nChannel time')
+    print('  frames on the channel          %6.2f%%' % (100.0 * busy / span))
+    print('  idle, devices in backoff       %6.2f%%' % (100.0 * contention / span))
+    print('  idle, nothing waiting          %6.2f%%' % (100.0 * idle / span))
+
+    print('\n  device   backoffs       sent   deferred   backoffs/deferred   aborted   q.drops   channel   MAC delay (ms)')
+    for d in range(devices):
+        mine = trace['device'] == d
+        backoffs = np.count_nonzero(mine & (event == MAC_BACKOFF))
+        starts = mine & (event == MAC_TX_BEGIN)
+        sent = np.count_nonzero(starts)
+        deferred = np.count_nonzero(starts & (trace['attempt'] > 0))
+        aborted = np.count_nonzero(mine & (event == MAC_TX_ABORT))
+        drops = np.count_nonzero(mine & (event == MAC_QUEUE_DROP))
+        begin = trace['time'][starts]
+        end = trace['time'][mine & (event == MAC_TX_END)]
+        on_channel = (end[:len(begin)] - begin[:len(end)]).sum()
+        print('  %6d %10d %10d %9.1f%% %19.2f %9d %9d %8.2f%% %16.3f' % (
+            d, backoffs, sent, 100.0 * deferred / max(sent, 1), trace['attempt'][starts].sum() / max(deferred, 1),
+            aborted, drops, 100.0 * on_channel / span, mac_delay(trace, d)))
+
+    # Backoffs per frame (255 means 255 or more)
+    needed = np.bincount(trace['attempt'][(event == MAC_TX_BEGIN) | (event == MAC_TX_ABORT)])
+    total = needed.sum()
+    print('\n  backoffs before sent/aborted   frames   share')
+    for n, count in enumerate(needed):
+        if count > 0:
+            print('  %28d %8d %6.2f%%' % (n, count, 100.0 * count / total))
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -1,11 +1,17 @@
+import os
+import sys
 import matplotlib.pyplot as plt
 import numpy as np
 
+# Directory holding the .dat files: the current one, or a run directory
+# written by csma --outDir (e.g. one of sweep.py's runs)
+data_dir = sys.argv[1] if len(sys.argv) > 1 else '.'
+
 # Read data from files
 def read_data(filename):
     time = []
     value = []
-    with open(filename, 'r') as f:
+    with open(os.path.join(data_dir, filename), 'r') as f:
         for line in f:
             t, v = map(float, line.strip().split())
             time.append(t)
@@ -55,5 +61,5 @@ plt.grid(True)
 plt.tight_layout()
 
 # Save and display the plot
-plt.savefig('Network_metrics.png', dpi=300, bbox_inches='tight')
+plt.savefig(os.path.join(data_dir, 'Network_metrics.png'), dpi=300, bbox_inches='tight')
 #plt.show()  # Display the plot
@@ -0,0 +1,112 @@
+import argparse
+import itertools
+import os
+import subprocess
+import sys
+from concurrent.futures import ThreadPoolExecutor, as_completed
+
+# Parameter sweep for csma.cc: every combination of node count, data rate and
+# packet size, repeated with run numbers 1..runs, as parallel processes.
+# Each run writes into its own directory (--outDir) with its own RNG run
+# number (--runNumber), so runs never share files. Their summary.dat files
+# are then collected into one table, results.dat (one row per run, columns
+# named in the header line), plus the mean over runs per configuration.
+#
+# Build csma once and pass the executable, e.g. after ./ns3 build:
+#   python3 sweep.py --binary build/scratch/ns3.40-csma-default \
+#       --nodes 2 5 10 20 --rates 5 10 25 --sizes 512 1460 --runs 3
+# Runs that already have a summary.dat are not repeated (so an interrupted
+# sweep can be resumed); --force reruns them.
+
+def parse_args():
+    parser = argparse.ArgumentParser(description='Parallel csma.cc parameter sweep')
+    parser.add_argument('--binary', required=True, help='compiled csma executable')
+    parser.add_argument('--nodes', type=int, nargs='+', default=[5])
+    parser.add_argument('--rates', type=int, nargs='+', default=[25], help='per-flow data rates (Mbps)')
+    parser.add_argument('--sizes', type=int, nargs='+', default=[1460], help='packet sizes (bytes)')
+    parser.add_argument('--runs', type=int, default=1, help='replications per configuration')
+    parser.add_argument('--simTime', type=int, default=60)
+    parser.add_argument('--jobs', type=int, default=os.cpu_count() or 1)
+    parser.add_argument('--out', default='sweep', help='directory for run directories and results')
+    parser.add_argument('--force', action='store_true', help='rerun runs that already finished')
+    return parser.parse_args()
+
+def run_dir(out, nodes, rate, size, run):
+    return os.path.join(out, 'n%d_r%dM_s%dB_run%d' % (nodes, rate, size, run))
+
+def read_summary(path):
+    values = {}
+    with open(path, 'r') as f:
+        for line in f:
+            parts = line.split()
+            if len(parts) == 2:
+                values[parts[0]] = parts[1]
+    return values
+
+def run_one(args, nodes, rate, size, run):
+    directory = run_dir(args.out, nodes, rate, size, run)
+    summary = os.path.join(directory, 'summary.dat')
+    if os.path.exists(summary) and not args.force:
+        return directory, 0
+    os.makedirs(directory, exist_ok=True)
+    command = [os.path.abspath(args.binary),
+               '--nNodes', str(nodes), '--dataRate', str(rate), '--packetSize', str(size),
+               '--simTime', str(args.simTime), '--outDir', directory, '--runNumber', str(run)]
+    with open(os.path.join(directory, 'log.txt'), 'w') as log:
+        code = subprocess.call(command, stdout=log, stderr=subprocess.STDOUT)
+    return directory, code
+
+def main():
+    args = parse_args()
+    os.makedirs(args.out, exist_ok=True)
+    grid = list(itertools.product(args.nodes, args.rates, args.sizes, range(1, args.runs + 1)))
+    print('%d runs on %d parallel jobs' % (len(grid), args.jobs))
+
+    failed = []
+    with ThreadPoolExecutor(max_workers=args.jobs) as pool:
+        futures = [pool.submit(run_one, args, *point) for point in grid]
+        for done, future in enumerate(as_completed(futures), 1):
+            directory, code = future.result()
+            if code != 0:
+                failed.append(directory)
+            print('[%d/%d] %s%s' % (done, len(grid), directory, '' if code == 0 else ' FAILED (see log.txt)'))
+            sys.stdout.flush()
+
+    # Collect the summaries in grid order
+    rows = []
+    for point in grid:
+        summary = os.path.join(run_dir(args.out, *point), 'summary.dat')
+        if os.path.exists(summary):
+            rows.append(read_summary(summary))
+    if not rows:
+        print('No results')
+        return 1
+    columns = list(rows[0].keys())
+    results = os.path.join(args.out, 'results.dat')
+    with open(results, 'w') as f:
+        f.write('# ' + ' '.join(columns) + '\n')
+        for row in rows:
+            f.write(' '.join(row.get(c, 'nan') for c in columns) + '\n')
+
+    # Mean over the runs of each configuration
+    keys = ['nNodes', 'dataRate', 'packetSize']
+    metrics = [c for c in columns if c not in keys + ['simTime', 'runNumber']]
+    groups = {}
+    for row in rows:
+        groups.setdefault(tuple(int(row[k]) for k in keys), []).append(row)
+    means = os.path.join(args.out, 'results_mean.dat')
+    with open(means, 'w') as f:
+        f.write('# ' + ' '.join(keys + ['runs'] + metrics) + '\n')
+        for key in sorted(groups):
+            group = groups[key]
+            mean = [sum(float(r[m]) for r in group) / len(group) for m in metrics]
+            f.write(' '.join(str(k) for k in key) + ' %d ' % len(group) + ' '.join('%.6g' % v for v in mean) + '\n')
+
+    print('%d runs collected into %s (means per configuration in %s)' % (len(rows), results, means))
+    if failed:
+        print('%d runs failed' % len(failed))
+        return 1
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main())